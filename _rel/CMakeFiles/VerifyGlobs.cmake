@@ -0,0 +1,51 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by CMake Version 3.25
+cmake_policy(SET CMP0009 NEW)
+
+# project_sources at CMakeLists.txt:26 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/[a-zA-Z]*.cpp")
+set(OLD_GLOB
+  "/root/repo/_gate_build/CMakeFiles/3.25.1/CompilerIdCXX/CMakeCXXCompilerId.cpp"
+  "/root/repo/_rel/CMakeFiles/3.25.1/CompilerIdCXX/CMakeCXXCompilerId.cpp"
+  "/root/repo/lib/iir/biquad_cascade.cpp"
+  "/root/repo/lib/iir/cascade_iir.cpp"
+  "/root/repo/lib/iir/desire_spec.cpp"
+  "/root/repo/lib/iir/eval_cache.cpp"
+  "/root/repo/lib/iir/fft.cpp"
+  "/root/repo/lib/iir/file_filter.cpp"
+  "/root/repo/lib/iir/freq_sweep.cpp"
+  "/root/repo/lib/iir/mapped_file.cpp"
+  "/root/repo/lib/iir/multi_spec.cpp"
+  "/root/repo/lib/iir/response_export.cpp"
+  "/root/repo/lib/iir/solution_store.cpp"
+  "/root/repo/lib/iir/surrogate.cpp"
+  "/root/repo/test/cascade_iir/cascade_iir_test.cpp"
+  "/root/repo/tools/bench_response_engine.cpp"
+  "/root/repo/tools/filter_file.cpp"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_rel/CMakeFiles/cmake.verify_globs")
+endif()
+
+# project_sources at CMakeLists.txt:26 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/[a-zA-Z]*.hpp")
+set(OLD_GLOB
+  "/root/repo/include/biquad_cascade.hpp"
+  "/root/repo/include/cascade_iir.hpp"
+  "/root/repo/include/desire_spec.hpp"
+  "/root/repo/include/eval_cache.hpp"
+  "/root/repo/include/fft.hpp"
+  "/root/repo/include/file_filter.hpp"
+  "/root/repo/include/freq_sweep.hpp"
+  "/root/repo/include/mapped_file.hpp"
+  "/root/repo/include/multi_spec.hpp"
+  "/root/repo/include/parallel_for.hpp"
+  "/root/repo/include/response_export.hpp"
+  "/root/repo/include/solution_store.hpp"
+  "/root/repo/include/surrogate.hpp"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_rel/CMakeFiles/cmake.verify_globs")
+endif()
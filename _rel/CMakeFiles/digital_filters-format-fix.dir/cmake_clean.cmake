@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/digital_filters-format-fix"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/digital_filters-format-fix.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
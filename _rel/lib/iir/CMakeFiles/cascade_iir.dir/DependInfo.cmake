@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/iir/biquad_cascade.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/biquad_cascade.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/biquad_cascade.cpp.o.d"
+  "/root/repo/lib/iir/cascade_iir.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/cascade_iir.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/cascade_iir.cpp.o.d"
+  "/root/repo/lib/iir/desire_spec.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/desire_spec.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/desire_spec.cpp.o.d"
+  "/root/repo/lib/iir/eval_cache.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/eval_cache.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/eval_cache.cpp.o.d"
+  "/root/repo/lib/iir/fft.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/fft.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/fft.cpp.o.d"
+  "/root/repo/lib/iir/file_filter.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/file_filter.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/file_filter.cpp.o.d"
+  "/root/repo/lib/iir/freq_sweep.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/freq_sweep.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/freq_sweep.cpp.o.d"
+  "/root/repo/lib/iir/mapped_file.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/mapped_file.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/mapped_file.cpp.o.d"
+  "/root/repo/lib/iir/multi_spec.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/multi_spec.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/multi_spec.cpp.o.d"
+  "/root/repo/lib/iir/response_export.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/response_export.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/response_export.cpp.o.d"
+  "/root/repo/lib/iir/solution_store.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/solution_store.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/solution_store.cpp.o.d"
+  "/root/repo/lib/iir/surrogate.cpp" "lib/iir/CMakeFiles/cascade_iir.dir/surrogate.cpp.o" "gcc" "lib/iir/CMakeFiles/cascade_iir.dir/surrogate.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
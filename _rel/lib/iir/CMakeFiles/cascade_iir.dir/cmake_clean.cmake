@@ -0,0 +1,33 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cascade_iir.dir/biquad_cascade.cpp.o"
+  "CMakeFiles/cascade_iir.dir/biquad_cascade.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/cascade_iir.cpp.o"
+  "CMakeFiles/cascade_iir.dir/cascade_iir.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/desire_spec.cpp.o"
+  "CMakeFiles/cascade_iir.dir/desire_spec.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/eval_cache.cpp.o"
+  "CMakeFiles/cascade_iir.dir/eval_cache.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/fft.cpp.o"
+  "CMakeFiles/cascade_iir.dir/fft.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/file_filter.cpp.o"
+  "CMakeFiles/cascade_iir.dir/file_filter.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/freq_sweep.cpp.o"
+  "CMakeFiles/cascade_iir.dir/freq_sweep.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/mapped_file.cpp.o"
+  "CMakeFiles/cascade_iir.dir/mapped_file.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/multi_spec.cpp.o"
+  "CMakeFiles/cascade_iir.dir/multi_spec.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/response_export.cpp.o"
+  "CMakeFiles/cascade_iir.dir/response_export.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/solution_store.cpp.o"
+  "CMakeFiles/cascade_iir.dir/solution_store.cpp.o.d"
+  "CMakeFiles/cascade_iir.dir/surrogate.cpp.o"
+  "CMakeFiles/cascade_iir.dir/surrogate.cpp.o.d"
+  "libcascade_iir.a"
+  "libcascade_iir.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cascade_iir.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libcascade_iir.a"
+)
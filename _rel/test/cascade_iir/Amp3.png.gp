@@ -0,0 +1,15 @@
+set terminal pngcairo size 1280, 960
+set grid
+set xlabel 'Normalized angular frequency'
+set ylabel 'Amplitude'
+set key    font 'Times New Roman,15'
+set xlabel font 'Times New Roman,20'
+set ylabel font 'Times New Roman,20'
+set tics   font 'Times New Roman,15'
+set xrange [1.256637:3.141593]
+set xtics 0, 0.1*pi, pi
+set format x '%.1Pπ'
+set lmargin 20
+set bmargin 10
+set output 'Amp3.png'
+plot 'Amp3.png.dat' using (2*pi*$1):2 with lines title ""
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cascade-iir-test.dir/cascade_iir_test.cpp.o"
+  "CMakeFiles/cascade-iir-test.dir/cascade_iir_test.cpp.o.d"
+  "cascade-iir-test"
+  "cascade-iir-test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cascade-iir-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
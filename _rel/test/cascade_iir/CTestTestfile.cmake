@@ -0,0 +1,102 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/cascade_iir
+# Build directory: /root/repo/_rel/test/cascade_iir
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(cascade-iir-BandParam_new "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "BandParam_new")
+set_tests_properties(cascade-iir-BandParam_new PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-BandParam_new" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;13;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-Band_generator "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "Band_generator")
+set_tests_properties(cascade-iir-Band_generator PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-Band_generator" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;22;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-analyze_edges "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "analyze_edges")
+set_tests_properties(cascade-iir-analyze_edges PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-analyze_edges" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;31;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_new_single_band "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_new_single_band")
+set_tests_properties(cascade-iir-FilterParam_new_single_band PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_new_single_band" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;40;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_new_multi_band "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_new_multi_band")
+set_tests_properties(cascade-iir-FilterParam_new_multi_band PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_new_multi_band" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;49;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_read_csv "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_read_csv")
+set_tests_properties(cascade-iir-FilterParam_read_csv PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_read_csv" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;58;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_csw "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_csw")
+set_tests_properties(cascade-iir-FilterParam_csw PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_csw" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;67;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_desire_res "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_desire_res")
+set_tests_properties(cascade-iir-FilterParam_desire_res PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_desire_res" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;76;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_freq_res_se "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_freq_res_se")
+set_tests_properties(cascade-iir-FilterParam_freq_res_se PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_freq_res_se" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;85;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_freq_res_so "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_freq_res_so")
+set_tests_properties(cascade-iir-FilterParam_freq_res_so PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_freq_res_so" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;94;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_freq_res_no "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_freq_res_no")
+set_tests_properties(cascade-iir-FilterParam_freq_res_no PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_freq_res_no" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;103;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_freq_res_mo "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_freq_res_mo")
+set_tests_properties(cascade-iir-FilterParam_freq_res_mo PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_freq_res_mo" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;112;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-Filter_param_group_delay_se "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "Filter_param_group_delay_se")
+set_tests_properties(cascade-iir-Filter_param_group_delay_se PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-Filter_param_group_delay_se" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;121;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-Filter_param_group_delay_so "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "Filter_param_group_delay_so")
+set_tests_properties(cascade-iir-Filter_param_group_delay_so PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-Filter_param_group_delay_so" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;130;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-Filter_param_group_delay_no "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "Filter_param_group_delay_no")
+set_tests_properties(cascade-iir-Filter_param_group_delay_no PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-Filter_param_group_delay_no" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;139;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-Filter_param_group_delay_mo "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "Filter_param_group_delay_mo")
+set_tests_properties(cascade-iir-Filter_param_group_delay_mo PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-Filter_param_group_delay_mo" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;148;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_judge_stability_even "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_judge_stability_even")
+set_tests_properties(cascade-iir-FilterParam_judge_stability_even PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_judge_stability_even" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;157;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_judge_stability_odd "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_judge_stability_odd")
+set_tests_properties(cascade-iir-FilterParam_judge_stability_odd PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_judge_stability_odd" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;166;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_evaluate_objective_function "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_evaluate_objective_function")
+set_tests_properties(cascade-iir-FilterParam_evaluate_objective_function PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_evaluate_objective_function" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;175;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_init_coef "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_init_coef")
+set_tests_properties(cascade-iir-FilterParam_init_coef PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_init_coef" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;184;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_init_stable_coef "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_init_stable_coef")
+set_tests_properties(cascade-iir-FilterParam_init_stable_coef PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_init_stable_coef" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;193;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_gprint_amp "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_gprint_amp")
+set_tests_properties(cascade-iir-FilterParam_gprint_amp PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_gprint_amp" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;202;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_gprint_mag "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_gprint_mag")
+set_tests_properties(cascade-iir-FilterParam_gprint_mag PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_gprint_mag" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;211;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_pole_batch "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_pole_batch")
+set_tests_properties(cascade-iir-FilterParam_pole_batch PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_pole_batch" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;220;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_section_cache "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_section_cache")
+set_tests_properties(cascade-iir-FilterParam_section_cache PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_section_cache" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;229;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_result_cache "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_result_cache")
+set_tests_properties(cascade-iir-FilterParam_result_cache PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_result_cache" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;238;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_evaluate_batch "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_evaluate_batch")
+set_tests_properties(cascade-iir-FilterParam_evaluate_batch PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_evaluate_batch" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;247;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_parallel_sweep "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_parallel_sweep")
+set_tests_properties(cascade-iir-FilterParam_parallel_sweep PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_parallel_sweep" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;256;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-sweep_response "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "sweep_response")
+set_tests_properties(cascade-iir-sweep_response PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-sweep_response" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;265;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-ResponseExporter "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "ResponseExporter")
+set_tests_properties(cascade-iir-ResponseExporter PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-ResponseExporter" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;274;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_response_engine "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_response_engine")
+set_tests_properties(cascade-iir-FilterParam_response_engine PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_response_engine" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;283;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_fft_response "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_fft_response")
+set_tests_properties(cascade-iir-FilterParam_fft_response PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_fft_response" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;292;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_gen_tables "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_gen_tables")
+set_tests_properties(cascade-iir-FilterParam_gen_tables PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_gen_tables" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;301;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_copy "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_copy")
+set_tests_properties(cascade-iir-FilterParam_copy PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_copy" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;310;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_parity_dispatch "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_parity_dispatch")
+set_tests_properties(cascade-iir-FilterParam_parity_dispatch PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_parity_dispatch" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;319;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_coef_size_check "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_coef_size_check")
+set_tests_properties(cascade-iir-FilterParam_coef_size_check PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_coef_size_check" WILL_FAIL "TRUE" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;328;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_squared_error "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_squared_error")
+set_tests_properties(cascade-iir-FilterParam_squared_error PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_squared_error" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;341;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_objective_config "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_objective_config")
+set_tests_properties(cascade-iir-FilterParam_objective_config PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_objective_config" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;350;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_desire_spec "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_desire_spec")
+set_tests_properties(cascade-iir-FilterParam_desire_spec PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_desire_spec" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;359;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-BiquadCascade_impulse "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "BiquadCascade_impulse")
+set_tests_properties(cascade-iir-BiquadCascade_impulse PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-BiquadCascade_impulse" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;368;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-filter_file "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "filter_file")
+set_tests_properties(cascade-iir-filter_file PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-filter_file" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;377;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_quantized "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_quantized")
+set_tests_properties(cascade-iir-FilterParam_quantized PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_quantized" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;386;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_pole_param "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_pole_param")
+set_tests_properties(cascade-iir-FilterParam_pole_param PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_pole_param" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;395;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_riple_bound "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_riple_bound")
+set_tests_properties(cascade-iir-FilterParam_riple_bound PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_riple_bound" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;404;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-FilterParam_retarget "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "FilterParam_retarget")
+set_tests_properties(cascade-iir-FilterParam_retarget PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-FilterParam_retarget" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;413;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-MultiSpecEvaluator "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "MultiSpecEvaluator")
+set_tests_properties(cascade-iir-MultiSpecEvaluator PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-MultiSpecEvaluator" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;422;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-SolutionStore "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "SolutionStore")
+set_tests_properties(cascade-iir-SolutionStore PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-SolutionStore" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;431;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
+add_test(cascade-iir-SurrogateScreen "/root/repo/_rel/test/cascade_iir/cascade-iir-test" "SurrogateScreen")
+set_tests_properties(cascade-iir-SurrogateScreen PROPERTIES  LABELS "lib;cscade-iir;cascade-iir-SurrogateScreen" _BACKTRACE_TRIPLES "/root/repo/test/cascade_iir/CMakeLists.txt;440;add_test;/root/repo/test/cascade_iir/CMakeLists.txt;0;")
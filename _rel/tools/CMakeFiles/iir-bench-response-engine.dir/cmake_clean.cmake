@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/iir-bench-response-engine.dir/bench_response_engine.cpp.o"
+  "CMakeFiles/iir-bench-response-engine.dir/bench_response_engine.cpp.o.d"
+  "iir-bench-response-engine"
+  "iir-bench-response-engine.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/iir-bench-response-engine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/iir-filter-file.dir/filter_file.cpp.o"
+  "CMakeFiles/iir-filter-file.dir/filter_file.cpp.o.d"
+  "iir-filter-file"
+  "iir-filter-file.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/iir-filter-file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,79 @@
+/*
+ * biquad_cascade.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef BIQUAD_CASCADE_HPP_
+#define BIQUAD_CASCADE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace filter
+{
+    namespace iir
+    {
+        /* # 縦続型IIRフィルタの実行系
+         *   設計した係数列(a0, a1, a2[0], a2[1],..., b1, b2[0], b2[1],...)を
+         *   そのまま受け取り，多チャネルの信号をブロック単位でフィルタリングする
+         *
+         *   分子・分母のセクションを先頭から順に組にして2次セクションとし，
+         *   転置型直接形II(TDF-II)で計算する
+         *   (奇数次の1次セクションはc2 = 0の2次セクションとして扱い，
+         *    分子・分母のセクション数が異なる場合は足りない側を1とする)
+         *   ゲインa0は先頭のセクションの入力に掛ける
+         *
+         *   信号はフレーム(時刻)ごとに全チャネルを並べたインターリーブ形式
+         *   x[frame * nchannel + channel]とし，チャネル方向を内側のループとするため，
+         *   1チャネルが1つのSIMDレーンに対応してベクトル化される
+         *   内部状態はブロック間で保持し，processはメモリ確保を行わない
+         *
+         *   state : 内部状態[section][2][channel]
+         */
+        struct BiquadCascade
+        {
+        protected:
+
+            unsigned int nchannel;
+            double gain;
+            std::vector< double > nume1;    // 分子の1次の係数[section]
+            std::vector< double > nume2;    // 分子の2次の係数[section]
+            std::vector< double > deno1;    // 分母の1次の係数[section]
+            std::vector< double > deno2;    // 分母の2次の係数[section]
+            std::vector< double > state;
+
+        public:
+
+            static constexpr std::size_t lane_block = 16;    // 1度に処理するチャネル数
+
+            BiquadCascade(
+                unsigned int n_order,
+                unsigned int m_order,
+                const std::vector< double >& coef,
+                unsigned int input_nchannel );
+            ~BiquadCascade();
+
+            unsigned int channels() const { return nchannel; }
+            std::size_t sections() const { return nume1.size(); }
+
+            void process( const double* input, double* output, std::size_t nframe );
+            void reset();
+
+        protected:
+
+            template< std::size_t Lanes >
+            void process_lanes(
+                const double* input,
+                double* output,
+                std::size_t nframe,
+                std::size_t channel );
+        };
+
+    }    // namespace iir
+}    // namespace filter
+
+#endif /* BIQUAD_CASCADE_HPP_ */
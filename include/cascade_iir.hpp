@@ -12,17 +12,31 @@
 
 #define _USE_MATH_DEFINES
 
+#include "biquad_cascade.hpp"
+#include "desire_spec.hpp"
+#include "eval_cache.hpp"
+#include "fft.hpp"
+#include "file_filter.hpp"
+#include "freq_sweep.hpp"
+#include "parallel_for.hpp"
+#include "response_export.hpp"
+#include "solution_store.hpp"
+#include "surrogate.hpp"
+
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -100,8 +114,364 @@ namespace filter
 {
     namespace iir
     {
+        /* # 根の一括計算結果を格納する構造体
+         *   候補(係数列)ごとに`order`個の根を固定長で並べたSoA形式
+         *   根の並びは(1次セクションの根, 2次セクションの根の組, ...)で，
+         *   重解も2つの根として格納するため，判別式によらず形状は一定
+         *
+         *   real, imag : 根の実部・虚部 [count * order]
+         *   radius : 候補ごとの根の最大絶対値 [count]
+         *            (極の場合，1.0未満で安定．1.0との差が安定余裕)
+         */
+        struct RootBuffer
+        {
+            std::size_t count;
+            unsigned int order;
+            std::vector< double > real;
+            std::vector< double > imag;
+            std::vector< double > radius;
+
+            RootBuffer() : count( 0 ), order( 0 ) {}
+            RootBuffer( const RootBuffer& );
+            RootBuffer( RootBuffer&& ) noexcept;
+            RootBuffer& operator=( const RootBuffer& );
+            RootBuffer& operator=( RootBuffer&& ) noexcept;
+            ~RootBuffer();
+
+            // 容量が足りている場合は再確保しない
+            void resize(
+                std::size_t input_count,
+                unsigned int input_order,
+                bool with_radius )
+            {
+                count = input_count;
+                order = input_order;
+                real.resize( count * order );
+                imag.resize( count * order );
+                radius.resize( with_radius ? count : 0 );
+            }
+
+            std::complex< double > root( std::size_t c, unsigned int k ) const
+            {
+                return std::complex< double >(
+                    real[c * order + k], imag[c * order + k] );
+            }
+        };
+
+        /* # 一括評価のタイル寸法
+         *   freq_block : 1タイルあたりの周波数点数
+         *                (e^-jω, e^-j2ω, 所望特性の表がL1キャッシュに収まる大きさ)
+         *   cand_tile : 1タイルあたりの候補数
+         *               (係数列と誤差の途中結果がL2キャッシュに収まる大きさ)
+         */
+        struct TileConfig
+        {
+            std::size_t freq_block;
+            std::size_t cand_tile;
+
+            TileConfig() : freq_block( 256 ), cand_tile( 64 ) {}
+            TileConfig( std::size_t input_block, std::size_t input_tile )
+                : freq_block( input_block ), cand_tile( input_tile )
+            {}
+
+            static TileConfig detect( unsigned int opt_order );
+        };
+
+        /* # 周波数特性の計算方式
+         *   Auto : 次数の組と精度から規則で選択する(計測時間によらず決定的)
+         *   SectionProduct : 2次セクションの積
+         *   Horner : 分子・分母を直接型の多項式に展開し，Clenshawの漸化式で計算する
+         *   FFT : 展開した多項式をゼロ詰めして実数FFTで計算する
+         *         (全帯域の周波数点がFFTのビン間隔 1/N に乗る場合のみ)
+         */
+        enum class ResponseEngine
+        {
+            Auto,
+            SectionProduct,
+            Horner,
+            FFT
+        };
+
+        /* # カーネル内で用いる配列の参照
+         *   ptr : 先頭要素
+         *   n : 要素数
+         *
+         *   operator[]はFILTER_PARAM_CHECKEDが定義された場合(Debugビルドなど)のみ
+         *   添字を検査し，それ以外は生ポインタの参照と同じになる
+         *   添字の検査はat()を用いる
+         */
+        template< typename T >
+        struct ArrayView
+        {
+            const T* ptr;
+            std::size_t n;
+
+            std::size_t size() const { return n; }
+            bool empty() const { return n == 0; }
+            const T* data() const { return ptr; }
+            const T* begin() const { return ptr; }
+            const T* end() const { return ptr + n; }
+            const T& operator[]( std::size_t j ) const
+            {
+#ifdef FILTER_PARAM_CHECKED
+                check( j );
+#endif
+                return ptr[j];
+            }
+            const T& at( std::size_t j ) const
+            {
+                if ( j >= n )
+                {
+                    throw std::out_of_range( "ArrayView::at" );
+                }
+                return ptr[j];
+            }
+            void check( std::size_t j ) const
+            {
+                if ( j >= n )
+                {
+                    fprintf(
+                        stderr,
+                        "Error: [%s l.%d]Index is out of range.(index : %llu, size : "
+                        "%llu)\n",
+                        __FILE__, __LINE__, static_cast< unsigned long long >( j ),
+                        static_cast< unsigned long long >( n ) );
+                    exit( EXIT_FAILURE );
+                }
+            }
+        };
+
+        template< typename T >
+        inline ArrayView< T > make_view( const std::vector< T >& vec )
+        {
+            return ArrayView< T > { vec.data(), vec.size() };
+        }
+
+        // 周波数グリッドの表(1帯域分)の参照
+        typedef ArrayView< std::complex< double > > BandView;
+
+        /* # 周波数グリッドの表(全帯域)の参照
+         *   帯域iの要素はbase[offset[i]] ~ base[offset[i + 1] - 1]
+         *   参照先はGridTableが保持し，参照自体はポインタのコピーのみで複製できる
+         */
+        struct TableView
+        {
+            const std::complex< double >* base;
+            const std::size_t* offset;
+            std::size_t nband;
+
+            TableView() : base( nullptr ), offset( nullptr ), nband( 0 ) {}
+            TableView(
+                const std::complex< double >* input_base,
+                const std::size_t* input_offset,
+                std::size_t input_nband )
+                : base( input_base ), offset( input_offset ), nband( input_nband )
+            {}
+
+            std::size_t size() const { return nband; }
+            BandView operator[]( std::size_t i ) const
+            {
+#ifdef FILTER_PARAM_CHECKED
+                BandView { nullptr, nband }.check( i );
+#endif
+                return BandView { base + offset[i], offset[i + 1] - offset[i] };
+            }
+            BandView at( std::size_t i ) const
+            {
+                if ( i >= nband )
+                {
+                    throw std::out_of_range( "TableView::at" );
+                }
+                return ( *this )[i];
+            }
+        };
+
+        /* # 周波数グリッドの表
+         *   全帯域の値を帯域順に1つの連続した配列へ格納し，nplane個の表を並べる
+         *   (FilterParamではe^-jω, e^-j2ωの2面と，所望特性の1面の2つを持つ)
+         *   構築後は変更しないため，FilterParamのコピー間でshared_ptrにより共有する
+         *
+         *   offset : 帯域ごとの先頭位置(末尾に1面あたりの全点数)
+         *   value : 値[plane][point]
+         */
+        struct GridTable
+        {
+            std::vector< std::size_t > offset;
+            std::vector< std::complex< double > > value;
+
+            GridTable( const std::vector< std::size_t >& split, std::size_t nplane )
+                : offset( split.size() + 1, 0 )
+            {
+                for ( std::size_t i = 0; i < split.size(); ++i )
+                {
+                    offset[i + 1] = offset[i] + split[i];
+                }
+                value.resize( nplane * offset.back() );
+            }
+
+            std::size_t npoint() const { return offset.back(); }
+            std::complex< double >* plane_data( std::size_t plane )
+            {
+                return value.data() + plane * npoint();
+            }
+            TableView plane( std::size_t plane ) const
+            {
+                return TableView(
+                    value.data() + plane * npoint(), offset.data(), offset.size() - 1 );
+            }
+        };
+
+        /* # 固定小数点の係数の形式(Q形式)
+         *   整数qの係数の値を q * 2^-frac_bits とする
+         *   |q| < 2^53 の範囲では倍精度で誤差なく表せるため，
+         *   量子化した縦続型フィルタの特性を丸めの影響なく評価できる
+         *
+         *   frac_bits : 小数部のビット数
+         *   word_bits : 符号を含む語長(2以上54以下，0で語長の制限なし)
+         *               整数部のビット数は word_bits - frac_bits - 1 となり，
+         *               qは2の補数の範囲 [-2^(word_bits-1), 2^(word_bits-1) - 1] に限る
+         *               (例 : int16でb1 ∈ (-2, 2)を表すQ1.14はQFormat(14, 16))
+         *               制限なしの場合は倍精度で誤差なく表せる |q| < 2^53 に限る
+         */
+        struct QFormat
+        {
+            unsigned int frac_bits;
+            unsigned int word_bits;
+
+            explicit QFormat( unsigned int input_frac = 15, unsigned int input_word = 0 )
+                : frac_bits( input_frac ), word_bits( input_word )
+            {}
+            double lsb() const { return std::ldexp( 1.0, -static_cast< int >( frac_bits ) ); }
+            std::int64_t max_code() const
+            {
+                return ( std::int64_t( 1 ) << ( word_bits == 0 ? 53 : word_bits - 1 ) ) - 1;
+            }
+            std::int64_t min_code() const
+            {
+                return word_bits == 0 ? -max_code() : -max_code() - 1;
+            }
+            bool contains( std::int64_t code ) const
+            {
+                return code >= min_code() && code <= max_code();
+            }
+        };
+
+        /* # 表形式の所望特性の周波数・重み
+         *   表形式の所望特性ファイルから構築した場合のみ持ち，
+         *   目的関数の重みの表や，群遅延を変えた所望特性を作る際に用いる
+         *
+         *   freq : 周波数点の正規化周波数 [point]
+         *   weight : ファイルで与えた誤差の重み [point]
+         *   magnitude, phase : ファイルで与えた所望振幅・位相 [point]
+         */
+        struct SpecTable
+        {
+            std::vector< double > freq;
+            std::vector< double > weight;
+            std::vector< double > magnitude;
+            std::vector< double > phase;
+        };
+
+        /* # 次数の偶奇の組
+         *   構築時に決まり，周波数特性などの計算関数の選択に用いる
+         *   SE : 分子・分母とも偶数次
+         *   SO : 分子・分母とも奇数次
+         *   NO : 分子のみ奇数次
+         *   MO : 分母のみ奇数次
+         */
+        enum class OrderParity
+        {
+            SE,
+            SO,
+            NO,
+            MO
+        };
+
+        /* # 近似誤差のノルム
+         *   Max : 最大誤差(L∞ノルム)
+         *   L2 : 2乗平均平方根誤差
+         *   Lp : p乗平均のp乗根(pはObjectiveConfig::p)
+         *
+         *   L2, Lpは近似帯域の全点数で割った平均とするため，分割数によらない
+         */
+        enum class ErrorNorm
+        {
+            Max,
+            L2,
+            Lp
+        };
+
+        /* # 目的関数の設定
+         *   stability_weight : 安定性のペナルティの重み
+         *   riple_weight : 振幅隆起のペナルティの重み
+         *   norm : 近似誤差のノルム
+         *   p : Lpノルムの次数(norm == ErrorNorm::Lpの場合のみ用いる，1以上)
+         *   band_weight : 帯域ごとの誤差の重み関数(正規化周波数 -> 重み)
+         *                 空の場合は全帯域で1とし，要素が空の帯域も1とする
+         *                 (遷移域の要素は用いない)
+         *
+         *   重み関数は設定時に周波数グリッド上で評価して表にするため，
+         *   目的関数値の計算中には呼び出さない
+         */
+        struct ObjectiveConfig
+        {
+            double stability_weight;
+            double riple_weight;
+            ErrorNorm norm;
+            double p;
+            std::vector< std::function< double( double ) > > band_weight;
+
+            ObjectiveConfig()
+                : stability_weight( 100.0 ), riple_weight( 100.0 ),
+                  norm( ErrorNorm::Max ), p( 2.0 )
+            {}
+        };
+
+        /* # 目的関数の重みの表
+         *   ObjectiveConfigから作る評価用の表で，構築後は変更しない
+         *   weight : 点ごとに誤差の2乗へ掛ける係数 [point]
+         *            (帯域順で周波数グリッドと同じ並び，遷移域の値は用いない)
+         *            Max : w^2, L2 : w^2 / K, Lp : w^p / K
+         *            (wは重み関数の値，Kは近似帯域の全点数)
+         *   half_p : p / 2 (Lpで誤差の2乗からp乗を求める指数)
+         *   check_stability : 安定性のペナルティを計算する場合true
+         *                     (構成上安定な媒介変数表示の評価ではfalse)
+         */
+        struct ObjectiveTable
+        {
+            ErrorNorm norm;
+            bool check_stability;
+            double stability_weight;
+            double riple_weight;
+            double p;
+            double half_p;
+            std::vector< double > weight;
+        };
+
+        /* # 分母の媒介変数表示
+         *   分母のセクションを極または反射係数(PARCOR係数)で与え，構成上安定な係数列を作る
+         *   媒介変数の並びは係数列と同じ(a0, a1, ..., 分母の媒介変数)で，分母の部分のみ異なる
+         *   Polar : 2次セクションは共役な極の半径rと角度θ(b1 = -2r cosθ, b2 = r^2)
+         *           1次セクションは実数の極p(b1 = -p)
+         *           (異なる2つの実数の極を持つ2次セクションは表せない)
+         *   Reflection : 2次セクションは反射係数k1, k2(b1 = k1(1 + k2), b2 = k2)
+         *                1次セクションは反射係数k1(b1 = k1)
+         *   半径・極・反射係数の絶対値はr_max(< 1)で打ち切るため，
+         *   媒介変数がどの値でも安定な係数列となる
+         *   (Reflectionで打ち切るのは反射係数であり，極の半径はr_maxを超え得るが1未満に留まる)
+         */
+        enum class PoleForm
+        {
+            Polar,
+            Reflection
+        };
+
+        struct MultiSpecEvaluator;
+
         struct FilterParam
         {
+            friend struct MultiSpecEvaluator;
+
         protected:
 
             // フィルタパラメータ
@@ -116,25 +486,30 @@ namespace filter
 
             // 内部パラメータ
 
-            std::vector< std::vector< std::complex< double > > >
-                csw;    // 複素正弦波e^-jωを周波数帯域別に格納
-            std::vector< std::vector< std::complex< double > > >
-                csw2;    // 複素正弦波e^-j2ωを周波数帯域別に格納
-            std::vector< std::vector< std::complex< double > > >
-                desire_res;    // 所望特性の周波数特性
+            std::shared_ptr< const GridTable > grid_table;    // e^-jω, e^-j2ωの表
+            std::shared_ptr< const GridTable > desire_table;    // 所望特性の表
+            TableView csw;    // 複素正弦波e^-jωを周波数帯域別に参照
+            TableView csw2;    // 複素正弦波e^-j2ωを周波数帯域別に参照
+            TableView desire_res;    // 所望特性の周波数特性
 
-            std::function< std::vector< std::vector< std::complex< double > > >(
-                const FilterParam*, const std::vector< double >& ) >
-                freq_res_func;
-            std::function< std::vector< std::vector< double > >(
-                const FilterParam*, const std::vector< double >& ) >
-                group_delay_func;
-            std::function< double(
-                const FilterParam*, const std::vector< double >& ) >
-                stability_func;
+            OrderParity parity;    // 次数の偶奇の組(計算関数の選択に用いる)
 
-            std::function< std::vector< std::complex< double > >( const FilterParam*, const std::vector< double >& ) > pole_func;
-            std::function< std::vector< std::complex< double > >( const FilterParam*, const std::vector< double >& ) > zero_func;
+            std::shared_ptr< SectionCache >
+                section_cache;    // セクション応答のキャッシュ(無効時はnullptr)
+            std::shared_ptr< ResultCache >
+                result_cache;    // 評価値のキャッシュ(無効時はnullptr)
+            TileConfig tile_config;    // 一括評価のタイル寸法
+            unsigned int sweep_threads;    // 1候補の評価に用いるスレッド数
+            ResponseEngine engine;    // 周波数特性の計算方式(Autoは解決済み)
+            bool riple_bound;    // 遷移域の隆起の判定に区間の上界を用いる場合true
+            std::shared_ptr< const RealFFT > fft_plan;    // FFT方式の変換表(無効時はnullptr)
+            ObjectiveConfig objective_config;    // 目的関数の設定
+            std::shared_ptr< const ObjectiveTable >
+                objective_table;    // 目的関数の重みの表(objective_configから生成)
+            std::shared_ptr< const ObjectiveTable >
+                stable_objective_table;    // 安定性の判別を省いた重みの表(媒介変数表示の評価用)
+            std::shared_ptr< const SpecTable >
+                spec_table;    // 表形式の所望特性(帯域から構築した場合はnullptr)
 
 
             // 内部メソッド
@@ -142,7 +517,9 @@ namespace filter
             FilterParam()
                 : n_order( 0 ), m_order( 0 ), nsplit_approx( 0 ),
                   nsplit_transition( 0 ), group_delay( 0.0 ),
-                  threshold_riple( 1.0 )
+                  threshold_riple( 1.0 ), parity( OrderParity::SE ),
+                  sweep_threads( 1 ), engine( ResponseEngine::SectionProduct ),
+                  riple_bound( true )
             {}
 
             std::vector< std::vector< std::complex< double > > >
@@ -153,6 +530,29 @@ namespace filter
             freq_res_no( const std::vector< double >& ) const;
             std::vector< std::vector< std::complex< double > > >
             freq_res_mo( const std::vector< double >& ) const;
+            std::vector< std::vector< std::complex< double > > >
+            freq_res_section( const std::vector< double >& ) const;
+            std::vector< std::vector< std::complex< double > > >
+            freq_res_cached( const std::vector< double >& ) const;
+            std::shared_ptr< const SectionCache::Factor >
+            section_factor( double, double ) const;
+            std::vector< std::vector< std::complex< double > > >
+            freq_res_parallel( const std::vector< double >& ) const;
+            const std::vector< std::size_t >& band_offsets() const
+            {
+                return grid_table->offset;
+            }
+            void bind_grid(
+                std::shared_ptr< const GridTable >,
+                std::shared_ptr< const GridTable >,
+                std::size_t desire_plane = 0 );
+            void fill_desire( double, std::complex< double >* ) const;
+            std::vector< std::vector< std::complex< double > > >
+            freq_res_horner( const std::vector< double >& ) const;
+            ResponseEngine select_response_engine() const;
+            std::vector< std::vector< std::complex< double > > >
+            freq_res_fft( const std::vector< double >& ) const;
+            bool fft_bins( std::size_t, std::size_t, std::size_t&, std::size_t& ) const;
 
             std::vector< std::vector< double > >
             group_delay_se( const std::vector< double >& ) const;
@@ -163,14 +563,83 @@ namespace filter
             std::vector< std::vector< double > >
             group_delay_mo( const std::vector< double >& ) const;
 
+            void check_coef_size( const std::vector< double >& ) const;
+
+            // 振幅隆起の閾値の2乗(閾値が負の場合は全点を隆起とみなす)
+            double riple_threshold2() const
+            {
+                return threshold_riple >= 0.0 ? threshold_riple * threshold_riple : -1.0;
+            }
             double judge_stability_even( const std::vector< double >& ) const;
             double judge_stability_odd( const std::vector< double >& ) const;
 
+            typedef double ( FilterParam::*EvalFunc )(
+                const std::vector< double >&, const ObjectiveTable& ) const;
+            typedef void ( FilterParam::*TileFunc )(
+                const std::vector< std::vector< double > >&,
+                const std::vector< std::size_t >&,
+                std::vector< double >&,
+                const ObjectiveTable& ) const;
+
+            void setup_evaluation( const ObjectiveConfig& );
+            std::shared_ptr< const ObjectiveTable >
+            gen_objective_table( const ObjectiveConfig& ) const;
+            double evaluate_full( const std::vector< double >&, const ObjectiveTable& ) const;
+            double stability_penalty( const std::vector< double >&, const ObjectiveTable& ) const;
+            void evaluate_tiles(
+                const std::vector< std::vector< double > >&,
+                const std::vector< std::size_t >&,
+                std::vector< double >&,
+                const ObjectiveTable& ) const;
+            void map_pole_param( const double*, double*, PoleForm, double ) const;
+            EvalFunc select_kernel( ErrorNorm, bool ) const;
+            template< ErrorNorm Norm >
+            EvalFunc select_kernel( bool ) const;
+            TileFunc select_tile( ErrorNorm ) const;
+            template< ErrorNorm Norm >
+            TileFunc select_tile() const;
+            template< ErrorNorm Norm >
+            double evaluate_response(
+                const std::vector< std::vector< std::complex< double > > >&,
+                const ObjectiveTable& ) const;
+            template< bool NOdd, bool MOdd >
+            double transition_riple_bounded( const double*, unsigned int, double ) const;
+            template< bool NOdd, bool MOdd, ErrorNorm Norm >
+            double evaluate_kernel( const std::vector< double >&, const ObjectiveTable& ) const;
+            template< bool NOdd, bool MOdd, ErrorNorm Norm >
+            double evaluate_parallel_kernel(
+                const std::vector< double >&, const ObjectiveTable& ) const;
+            template< ErrorNorm Norm, typename Response >
+            double reduce_response( Response, const ObjectiveTable& ) const;
+            double evaluate_indexed(
+                const std::vector< double >&,
+                const std::complex< double >*,
+                const std::size_t* ) const;
+            template< ErrorNorm Norm >
+            void evaluate_neighbors_kernel(
+                const std::vector< std::int64_t >&,
+                QFormat,
+                std::vector< double >&,
+                const ObjectiveTable& ) const;
+            template< bool NOdd, bool MOdd, ErrorNorm Norm >
+            void evaluate_tile(
+                const std::vector< std::vector< double > >&,
+                const std::vector< std::size_t >&,
+                std::vector< double >&,
+                const ObjectiveTable& ) const;
+
             std::vector< std::complex< double > > pole_even( const std::vector< double >& ) const;
             std::vector< std::complex< double > > pole_odd( const std::vector< double >& ) const;
             std::vector< std::complex< double > > zero_even( const std::vector< double >& ) const;
             std::vector< std::complex< double > > zero_odd( const std::vector< double >& ) const;
 
+            void root_batch(
+                const std::vector< std::vector< double > >&,
+                unsigned int,
+                unsigned int,
+                RootBuffer&,
+                bool ) const;
+
 
         public:
 
@@ -180,14 +649,30 @@ namespace filter
                 BandParam,
                 unsigned int,
                 unsigned int,
-                double );
+                double,
+                const ObjectiveConfig& = ObjectiveConfig() );
             FilterParam(
                 unsigned int,
                 unsigned int,
                 std::vector< BandParam >,
                 unsigned int,
                 unsigned int,
-                double );
+                double,
+                const ObjectiveConfig& = ObjectiveConfig() );
+            FilterParam(
+                unsigned int,
+                unsigned int,
+                const std::string&,
+                double,
+                const ObjectiveConfig& = ObjectiveConfig() );
+
+            // 周波数グリッドの表は共有するため，コピーは表の大きさによらない
+            // 保持するメンバが多く，インライン展開すると肥大化するため翻訳単位で定義する
+            FilterParam( const FilterParam& );
+            FilterParam( FilterParam&& ) noexcept;
+            FilterParam& operator=( const FilterParam& );
+            FilterParam& operator=( FilterParam&& ) noexcept;
+            ~FilterParam();
 
             // get function
 
@@ -201,15 +686,121 @@ namespace filter
                 return nsplit_transition;
             }
             double gd() const { return group_delay; }
+            double threshold() const { return threshold_riple; }
+            TileConfig tiling() const { return tile_config; }
+            unsigned int parallel_sweep() const { return sweep_threads; }
+            ResponseEngine response_engine() const { return engine; }
+            bool riple_bounding() const { return riple_bound; }
+            const ObjectiveConfig& objective() const { return objective_config; }
 
             // set function
             /* # フィルタ構造体
              *   振幅隆起として検知する閾値を変更する
              *   デフォルト値は1.0
+             *   評価値のキャッシュは閾値に依存するため，新しいものに置き換える
              */
             void set_threshold_riple( double input )
             {
                 threshold_riple = input;
+                if ( result_cache )
+                {
+                    enable_result_cache( result_cache->max_entries() );
+                }
+            }
+
+            /* # フィルタ構造体
+             *   セクション応答のキャッシュを有効にする
+             *   交叉により親と同じセクションを持つ個体が多い場合に，
+             *   セクションの周波数グリッド上の値を再利用する
+             *   キャッシュはコピーした構造体同士で共有される
+             *
+             *   # 引数
+             *   size_t capacity : 保持するセクションの最大数
+             */
+            void enable_section_cache( std::size_t capacity )
+            {
+                section_cache = std::make_shared< SectionCache >( capacity );
+            }
+            void disable_section_cache() { section_cache.reset(); }
+
+            /* # フィルタ構造体
+             *   セクション応答のキャッシュを空にする
+             *   世代交代ごとに呼び出すことで，古い個体のセクションを捨てる
+             */
+            void clear_section_cache() const
+            {
+                if ( section_cache )
+                {
+                    section_cache->clear();
+                }
+            }
+            CacheStats section_cache_stats() const
+            {
+                return section_cache ? section_cache->stats() : CacheStats();
+            }
+
+            /* # フィルタ構造体
+             *   評価値のキャッシュを有効にする
+             *   evaluateの前段で，ビット列が完全に一致する係数列の評価値を再利用する
+             *   キャッシュはコピーした構造体同士で共有される
+             *
+             *   # 引数
+             *   size_t capacity : 保持する係数列の最大数
+             */
+            void enable_result_cache( std::size_t capacity )
+            {
+                result_cache = std::make_shared< ResultCache >( capacity );
+            }
+            void disable_result_cache() { result_cache.reset(); }
+
+            /* # フィルタ構造体
+             *   一括評価のタイル寸法を変更する
+             *   デフォルトはキャッシュ容量から決めた値(TileConfig::detect)
+             */
+            void set_tiling( const TileConfig& input ) { tile_config = input; }
+
+            /* # フィルタ構造体
+             *   1候補の周波数特性・目的関数値の計算を複数スレッドで行う
+             *   検証や描画のための非常に密なグリッドを想定し，
+             *   周波数グリッドを連続した区間に分割して各スレッドに割り当てる
+             *   目的関数値は固定長(4096点)の区間ごとの部分和を区間順に集約するため，
+             *   2以上のスレッド数(0を含む)では結果はスレッド数によらず一致する
+             *   1スレッド(無効)の場合は全点を順に足すため，L2・Lpノルムでは丸め誤差程度異なる
+             *   計算方式がSectionProductの場合のみ用いる(HornerとFFTはそれぞれの方式で計算する)
+             *
+             *   # 引数
+             *   unsigned int nthreads : スレッド数(1で無効，0でハードウェアのスレッド数)
+             */
+            void set_parallel_sweep( unsigned int nthreads )
+            {
+                sweep_threads = nthreads;
+            }
+
+            /* # フィルタ構造体
+             *   遷移域の振幅隆起の判定で，区間ごとの|H|の上界が閾値以下となる
+             *   部分区間の点の計算を省くかを切り替える
+             *   省くのは隆起とならないことが示せた点のみのため，目的関数値は変わらない
+             *   (セクション積の評価・一括評価に適用，デフォルトは有効)
+             */
+            void set_riple_bound( bool input ) { riple_bound = input; }
+
+            FilterParam retarget( double gd ) const;
+            std::vector< FilterParam > retarget_batch( const std::vector< double >& gds ) const;
+            FilterParam with_threshold( double threshold ) const;
+
+            void set_response_engine( ResponseEngine input );
+            void set_objective( const ObjectiveConfig& input );
+            std::size_t fft_size() const { return fft_plan ? fft_plan->size() : 0; }
+            void clear_result_cache() const
+            {
+                if ( result_cache )
+                {
+                    result_cache->clear();
+                }
+            }
+            CacheStats result_cache_stats() const
+            {
+                return result_cache ? result_cache->stats() : CacheStats();
             }
 
             // normal function
@@ -219,6 +810,10 @@ namespace filter
              *   応じて，縦続型IIRフィルタの周波数特性を計算する
              *   また，係数列も次数によって適宜分割される
              *
+             *   計算方式(response_engine)が優先し，HornerとFFTはセクションキャッシュ・
+             *   並列計算の設定によらずその方式で計算する
+             *   SectionProductの場合のみ，セクションキャッシュ，並列計算の順に用いる
+             *
              *   # 引数
              *   vector<double> coef : 係数列(a0, a1, a2[0], a2[1],..., b1,
              * b2[0], b2[1],...) #返り値 vector<vector<complex<double>>>
@@ -227,7 +822,24 @@ namespace filter
             std::vector< std::vector< std::complex< double > > >
             freq_res( const std::vector< double >& coef ) const
             {
-                return this->freq_res_func( this, coef );
+                check_coef_size( coef );
+                if ( engine == ResponseEngine::Horner )
+                {
+                    return freq_res_horner( coef );
+                }
+                if ( engine == ResponseEngine::FFT )
+                {
+                    return freq_res_fft( coef );
+                }
+                if ( section_cache )
+                {
+                    return freq_res_cached( coef );
+                }
+                if ( sweep_threads != 1 )
+                {
+                    return freq_res_parallel( coef );
+                }
+                return freq_res_section( coef );
             }
 
             /* # フィルタ構造体
@@ -244,7 +856,15 @@ namespace filter
             std::vector< std::vector< double > >
             group_delay_res( const std::vector< double >& coef ) const
             {
-                return this->group_delay_func( this, coef );
+                check_coef_size( coef );
+                switch ( parity )
+                {
+                    case OrderParity::SO: return group_delay_so( coef );
+                    case OrderParity::NO: return group_delay_no( coef );
+                    case OrderParity::MO: return group_delay_mo( coef );
+                    case OrderParity::SE:
+                    default: return group_delay_se( coef );
+                }
             }
 
             /* # フィルタ構造体
@@ -257,7 +877,9 @@ namespace filter
              */
             double judge_stability( const std::vector< double >& coef ) const
             {
-                return this->stability_func( this, coef );
+                check_coef_size( coef );
+                return ( m_order % 2 ) == 0 ? judge_stability_even( coef )
+                                            : judge_stability_odd( coef );
             }
 
             /* # フィルタ構造体
@@ -270,7 +892,8 @@ namespace filter
              */
             std::vector< std::complex< double > > pole_res( const std::vector< double >& coef ) const
             {
-                return this->pole_func( this, coef );
+                check_coef_size( coef );
+                return ( m_order % 2 ) == 0 ? pole_even( coef ) : pole_odd( coef );
             }
 
             /* # フィルタ構造体
@@ -283,10 +906,65 @@ namespace filter
              */
             std::vector< std::complex< double > > zero_res( const std::vector< double >& coef ) const
             {
-                return this->zero_func( this, coef );
+                check_coef_size( coef );
+                return ( n_order % 2 ) == 0 ? zero_even( coef ) : zero_odd( coef );
+            }
+
+            /* # フィルタ構造体
+             *   極の一括計算関数
+             *   複数の係数列の極を固定長のSoAバッファに書き込む
+             *   バッファは容量が足りていれば再確保しないため，
+             *   世代ごとに使い回すことを想定する
+             *
+             *   # 引数
+             *   vector<vector<double>> coefs : 係数列の配列
+             *   RootBuffer& poles : 出力先(order = pole_order())
+             *   bool with_radius : 候補ごとの最大極半径を計算するか
+             */
+            void pole_batch(
+                const std::vector< std::vector< double > >& coefs,
+                RootBuffer& poles,
+                bool with_radius = false ) const
+            {
+                root_batch( coefs, n_order + 1, m_order, poles, with_radius );
+            }
+
+            /* # フィルタ構造体
+             *   零点の一括計算関数
+             *   pole_batchの零点版(order = zero_order())
+             */
+            void zero_batch(
+                const std::vector< std::vector< double > >& coefs,
+                RootBuffer& zeros,
+                bool with_radius = false ) const
+            {
+                root_batch( coefs, 1, n_order, zeros, with_radius );
             }
 
             double evaluate( const std::vector< double >& ) const;
+            double evaluate( const std::vector< double >&, const ObjectiveConfig& ) const;
+            std::vector< double >
+            evaluate_batch( const std::vector< std::vector< double > >& ) const;
+            double evaluate_quantized( const std::vector< std::int64_t >&, QFormat ) const;
+            std::vector< double >
+            evaluate_neighbors( const std::vector< std::int64_t >&, QFormat ) const;
+            std::vector< std::int64_t >
+            search_quantized( const std::vector< double >&, QFormat, unsigned int ) const;
+            static std::vector< std::int64_t > quantize( const std::vector< double >&, QFormat );
+            static std::vector< double > dequantize( const std::vector< std::int64_t >&, QFormat );
+            std::vector< double >
+            pole_param_to_coef( const std::vector< double >&, PoleForm, double ) const;
+            void pole_param_to_coef_batch(
+                const std::vector< std::vector< double > >&,
+                PoleForm,
+                double,
+                std::vector< std::vector< double > >& ) const;
+            std::vector< double >
+            coef_to_pole_param( const std::vector< double >&, PoleForm ) const;
+            double evaluate_pole_param( const std::vector< double >&, PoleForm, double ) const;
+            std::vector< double > evaluate_pole_param_batch(
+                const std::vector< std::vector< double > >&, PoleForm, double ) const;
+            std::vector< double > init_pole_param( const double, const double, PoleForm, double ) const;
             std::vector< double >
             init_coef( const double, const double, const double ) const;
             std::vector< double >
@@ -311,12 +989,20 @@ namespace filter
             static std::vector< BandParam > gen_bands( FilterType, Args... );
             static FilterType analyze_type( const std::string& );
             static std::vector< double > analyze_edges( const std::string& );
+            static std::string analyze_spec_path( const std::string& );
             static std::vector< std::complex< double > >
             gen_csw( const BandParam&, const unsigned int );
             static std::vector< std::complex< double > >
             gen_csw2( const BandParam&, const unsigned int );
             static std::vector< std::complex< double > > gen_desire_res(
                 const BandParam&, const unsigned int, const double );
+            static void gen_tables(
+                const BandParam&,
+                const unsigned int,
+                const double,
+                std::complex< double >*,
+                std::complex< double >*,
+                std::complex< double >* );
         };
 
     }    // namespace iir
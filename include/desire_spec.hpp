@@ -0,0 +1,69 @@
+/*
+ * desire_spec.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef DESIRE_SPEC_HPP_
+#define DESIRE_SPEC_HPP_
+
+#include "mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace filter
+{
+    namespace iir
+    {
+        /* # 表形式の所望特性ファイル
+         *   イコライザや補償フィルタなど，帯域で表せない所望特性を
+         *   周波数点ごとの振幅・位相・重みの表で与える
+         *   ファイルはmmapで読み込み，列をそのまま参照するため，
+         *   点数によらず読み込み時のメモリ確保は無い
+         *
+         *   バイナリ形式(列指向，リトルエンディアンを想定)
+         *     char[8] magic : "FPSPEC01"
+         *     uint64 npoint
+         *     double freq[npoint] : 正規化周波数 [0:0.5] (昇順)
+         *     double magnitude[npoint] : 所望振幅 |D| (線形)
+         *     double phase[npoint] : 所望位相 [rad] (群遅延による位相 -2πf*gdに加える)
+         *     double weight[npoint] : 誤差の重み(0以上，0の点は誤差に含めない)
+         */
+        struct MappedSpec
+        {
+        protected:
+
+            MappedFile file;
+            std::size_t npoint;
+            const double* column;
+
+        public:
+
+            static constexpr std::size_t header_bytes = 16;
+
+            explicit MappedSpec( const std::string& path );
+
+            std::size_t size() const { return npoint; }
+            const double* freq() const { return column; }
+            const double* magnitude() const { return column + npoint; }
+            const double* phase() const { return column + 2 * npoint; }
+            const double* weight() const { return column + 3 * npoint; }
+        };
+
+        void write_desire_spec(
+            const std::string& path,
+            const double* freq,
+            const double* magnitude,
+            const double* phase,
+            const double* weight,
+            std::size_t count );
+
+    }    // namespace iir
+}    // namespace filter
+
+#endif /* DESIRE_SPEC_HPP_ */
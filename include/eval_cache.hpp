@@ -0,0 +1,194 @@
+/*
+ * eval_cache.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef EVAL_CACHE_HPP_
+#define EVAL_CACHE_HPP_
+
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace filter
+{
+    namespace iir
+    {
+        /* # キャッシュの統計情報
+         *   hits : ヒット回数
+         *   misses : ミス回数
+         *   evictions : 容量超過により破棄した回数
+         *   entries : 現在の格納数
+         */
+        struct CacheStats
+        {
+            std::size_t hits;
+            std::size_t misses;
+            std::size_t evictions;
+            std::size_t entries;
+
+            CacheStats() : hits( 0 ), misses( 0 ), evictions( 0 ), entries( 0 )
+            {}
+
+            double hit_rate() const
+            {
+                const std::size_t total = hits + misses;
+                return total == 0 ? 0.0
+                                  : static_cast< double >( hits )
+                                        / static_cast< double >( total );
+            }
+        };
+
+        /* doubleのビット列をそのまま整数として取り出す
+         *   キャッシュのキーは値ではなくビット列で比較する
+         */
+        inline std::uint64_t double_bits( const double value )
+        {
+            std::uint64_t bits;
+            std::memcpy( &bits, &value, sizeof( bits ) );
+            return bits;
+        }
+
+        /* 64bit整数の混合関数(splitmix64の最終段)
+         */
+        inline std::uint64_t mix_bits( std::uint64_t x )
+        {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebULL;
+            x ^= x >> 31;
+            return x;
+        }
+
+        /* # セクション応答のキャッシュ
+         *   2次セクション(1 + c1 e^-jω + c2 e^-j2ω)の係数の組をキーとして，
+         *   周波数グリッド全体(帯域順に連結)での値を保持する
+         *   1次セクションはc2 = 0として扱う
+         *
+         *   容量を超えた場合は最も長く使われていない要素から破棄する(LRU)
+         *   全ての操作は排他制御されるため，複数スレッドから共有できる
+         *   値の計算はロックの外で行い，同じキーが同時に計算された場合は
+         *   先に登録された値を採用する
+         */
+        struct SectionCache
+        {
+        public:
+
+            using Factor = std::vector< std::complex< double > >;
+
+        protected:
+
+            struct Key
+            {
+                std::uint64_t c1;
+                std::uint64_t c2;
+
+                bool operator==( const Key& other ) const
+                {
+                    return c1 == other.c1 && c2 == other.c2;
+                }
+            };
+
+            struct KeyHash
+            {
+                std::size_t operator()( const Key& key ) const
+                {
+                    return static_cast< std::size_t >(
+                        mix_bits( key.c1 ^ mix_bits( key.c2 ) ) );
+                }
+            };
+
+            using Entry = std::pair<
+                std::shared_ptr< const Factor >,
+                std::list< Key >::iterator >;
+
+            mutable std::mutex mtx;
+            std::size_t capacity;
+            std::list< Key > lru;    // 先頭ほど最近使用した要素
+            std::unordered_map< Key, Entry, KeyHash > table;
+            CacheStats stat;
+
+        public:
+
+            explicit SectionCache( std::size_t input_capacity );
+            ~SectionCache();
+
+            std::shared_ptr< const Factor > find( double c1, double c2 );
+            std::shared_ptr< const Factor >
+            insert( double c1, double c2, Factor&& factor );
+            void clear();
+            CacheStats stats() const;
+        };
+
+        /* # 評価値のキャッシュ
+         *   係数列のビット列が完全に一致する場合に，目的関数値を再利用する
+         *   エリート保存や停滞した集団で同じ係数列が繰り返し評価される場合を想定する
+         *
+         *   キーは係数列のビット列のハッシュ値で，衝突に備えて係数列自体も保持して比較する
+         *   ハッシュ値で選択したシャードごとにロックとLRUを持つため，
+         *   複数スレッドからの同時アクセスで競合しにくい
+         *   容量はシャードに過不足なく分割するため(容量が小さい場合はシャード数を減らす)，
+         *   保持する係数列は全体で容量を超えない
+         *   (LRUはシャードごとのため，偏った場合は容量に達する前に追い出される)
+         */
+        struct ResultCache
+        {
+        protected:
+
+            static constexpr std::size_t max_shard = 16;
+
+            struct Node
+            {
+                std::uint64_t hash;
+                std::vector< double > coef;
+                double value;
+            };
+
+            struct Shard
+            {
+                std::mutex mtx;
+                std::list< Node > lru;    // 先頭ほど最近使用した要素
+                std::unordered_map< std::uint64_t, std::list< Node >::iterator >
+                    table;
+                CacheStats stat;
+                std::size_t capacity;
+            };
+
+            std::size_t capacity;
+            std::size_t nshard;
+            std::unique_ptr< Shard[] > shards;
+
+            Shard& select( std::uint64_t hash ) const
+            {
+                return shards[static_cast< std::size_t >( ( hash >> 32 ) % nshard )];
+            }
+
+        public:
+
+            explicit ResultCache( std::size_t input_capacity );
+            ~ResultCache();
+
+            static std::uint64_t hash( const std::vector< double >& coef );
+
+            bool find( const std::vector< double >& coef, double& value );
+            void insert( const std::vector< double >& coef, double value );
+            void clear();
+            CacheStats stats() const;
+            std::size_t max_entries() const { return capacity; }
+        };
+
+    }    // namespace iir
+}    // namespace filter
+
+#endif /* EVAL_CACHE_HPP_ */
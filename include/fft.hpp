@@ -0,0 +1,48 @@
+/*
+ * fft.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef FFT_HPP_
+#define FFT_HPP_
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace filter
+{
+    /* # 実数列の高速フーリエ変換
+     *   点数Nは2のべき乗(2以上)とする
+     *   N/2点の複素FFT(基数2，時間間引き)に偶数・奇数番目の要素を詰めて計算し，
+     *   X[k] = Σ x[n] e^-j2πkn/N (k = 0..N/2)を求める
+     *   回転因子とビット反転の表は構築時に1度だけ計算する
+     */
+    struct RealFFT
+    {
+    protected:
+
+        std::size_t npoint;
+        std::vector< std::complex< double > > twiddle;    // e^-j2πk/N (k = 0..N/2-1)
+        std::vector< std::size_t > bitrev;    // N/2点のビット反転表
+
+    public:
+
+        explicit RealFFT( std::size_t input_npoint );
+        ~RealFFT();
+
+        std::size_t size() const { return npoint; }
+
+        void forward(
+            const double* input, std::size_t count, std::complex< double >* output ) const;
+
+        static bool is_pow2( std::size_t n ) { return n >= 2 && ( n & ( n - 1 ) ) == 0; }
+    };
+
+}    // namespace filter
+
+#endif /* FFT_HPP_ */
@@ -0,0 +1,90 @@
+/*
+ * file_filter.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef FILE_FILTER_HPP_
+#define FILE_FILTER_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace filter
+{
+    namespace iir
+    {
+        struct FilterParam;
+
+        /* # 標本のデータ形式
+         *   Int16, Int32 : 符号付き整数(値をそのまま実数として扱い，書き出し時は
+         *                  四捨五入して範囲に飽和させる)
+         *   Float32, Float64 : IEEE 754の単精度・倍精度
+         */
+        enum class SampleFormat
+        {
+            Int16,
+            Int32,
+            Float32,
+            Float64
+        };
+
+        std::size_t sample_bytes( SampleFormat format );
+        SampleFormat analyze_sample_format( const std::string& input );
+
+        /* # ファイルのフィルタリングの設定
+         *   input_format, output_format : 入出力の標本のデータ形式
+         *   nchannel : チャネル数(標本はチャネルをインターリーブして並ぶ)
+         *   chunk_frames : 1度に変換・処理するフレーム数(0でL2キャッシュから決める)
+         *   nthreads : スレッド数(0でハードウェアのスレッド数)
+         *   warmup_tolerance : 区間の境界で許す相対誤差
+         *                      (前の区間から引き継ぐ状態の代わりに，
+         *                       境界の手前から助走して状態を作る長さを決める)
+         */
+        struct FileFilterConfig
+        {
+            SampleFormat input_format;
+            SampleFormat output_format;
+            unsigned int nchannel;
+            std::size_t chunk_frames;
+            unsigned int nthreads;
+            double warmup_tolerance;
+
+            FileFilterConfig()
+                : input_format( SampleFormat::Float64 ),
+                  output_format( SampleFormat::Float64 ), nchannel( 1 ), chunk_frames( 0 ),
+                  nthreads( 0 ), warmup_tolerance( 1.0e-12 )
+            {}
+        };
+
+        /* # ファイルのフィルタリングの結果
+         *   nframe : 処理したフレーム数
+         *   nsegment : 並列に処理した区間の数
+         *   warmup_frames : 2番目以降の区間の助走のフレーム数(次数分を含む，安定でない場合は0)
+         *   pole_radius : 極の最大絶対値(助走の長さの算出に用いた値)
+         */
+        struct FileFilterStats
+        {
+            std::size_t nframe;
+            std::size_t nsegment;
+            std::size_t warmup_frames;
+            double pole_radius;
+        };
+
+        std::size_t warmup_length( double pole_radius, double tolerance );
+
+        FileFilterStats filter_file(
+            const FilterParam& param,
+            const std::vector< double >& coef,
+            const std::string& input_path,
+            const std::string& output_path,
+            const FileFilterConfig& config );
+
+    }    // namespace iir
+}    // namespace filter
+
+#endif /* FILE_FILTER_HPP_ */
@@ -0,0 +1,194 @@
+/*
+ * freq_sweep.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef FREQ_SWEEP_HPP_
+#define FREQ_SWEEP_HPP_
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace filter
+{
+    namespace iir
+    {
+        /* 縦続型IIRフィルタの1点の周波数特性を計算する
+         *   奇数次の場合は先頭を1次セクションとし，残りを2次セクションとする
+         *
+         * # 引数
+         * double* coef : 係数列(a0, a1, a2[0], a2[1],..., b1, b2[0], b2[1],...)
+         * unsigned int n_order, m_order : 分子・分母の次数
+         * complex<double> w, w2 : e^-jω, e^-j2ω
+         */
+        inline std::complex< double > cascade_response(
+            const double* coef,
+            const unsigned int n_order,
+            const unsigned int m_order,
+            const std::complex< double > w,
+            const std::complex< double > w2 )
+        {
+            std::complex< double > nume( 1.0, 0.0 );
+            std::complex< double > deno( 1.0, 0.0 );
+
+            const double* a = coef + 1;
+            if ( ( n_order % 2 ) == 1 )
+            {
+                nume *= 1.0 + a[0] * w;
+            }
+            for ( unsigned int n = n_order % 2; n < n_order; n += 2 )
+            {
+                nume *= 1.0 + a[n] * w + a[n + 1] * w2;
+            }
+
+            const double* b = coef + 1 + n_order;
+            if ( ( m_order % 2 ) == 1 )
+            {
+                deno *= 1.0 + b[0] * w;
+            }
+            for ( unsigned int m = m_order % 2; m < m_order; m += 2 )
+            {
+                deno *= 1.0 + b[m] * w + b[m + 1] * w2;
+            }
+
+            return coef[0] * ( nume / deno );
+        }
+
+        /* 縦続型IIRフィルタの1点の周波数特性を計算する(偶奇を固定した版)
+         *   NOdd, MOdd : 分子・分母が奇数次の場合true
+         *   偶奇の分岐がコンパイル時に決まるため，呼び出し元のループに展開できる
+         *   演算の順序はcascade_responseと同じで，結果はビット単位で一致する
+         */
+        template< bool NOdd, bool MOdd >
+        inline std::complex< double > cascade_response_fixed(
+            const double* coef,
+            const unsigned int n_order,
+            const unsigned int m_order,
+            const std::complex< double > w,
+            const std::complex< double > w2 )
+        {
+            std::complex< double > nume( 1.0, 0.0 );
+            std::complex< double > deno( 1.0, 0.0 );
+
+            const double* a = coef + 1;
+            if ( NOdd )
+            {
+                nume *= 1.0 + a[0] * w;
+            }
+            for ( unsigned int n = NOdd ? 1 : 0; n < n_order; n += 2 )
+            {
+                nume *= 1.0 + a[n] * w + a[n + 1] * w2;
+            }
+
+            const double* b = coef + 1 + n_order;
+            if ( MOdd )
+            {
+                deno *= 1.0 + b[0] * w;
+            }
+            for ( unsigned int m = MOdd ? 1 : 0; m < m_order; m += 2 )
+            {
+                deno *= 1.0 + b[m] * w + b[m + 1] * w2;
+            }
+
+            return coef[0] * ( nume / deno );
+        }
+
+        /* 多項式 Σ p[k] e^-jkω (k = 0..degree)の値をClenshawの漸化式で計算する
+         *   e^-jkωが b_k = p_k + 2cosω b_{k+1} - b_{k+2} の漸化式を満たすことを用い，
+         *   実数の乗算1回・加算2回/次で計算する
+         *   ω = 0, π付近の高次多項式では桁落ちにより精度が低下する
+         *
+         * # 引数
+         * double* p : 多項式の係数(z^-1の昇べき)
+         * unsigned int degree : 次数
+         * double c, s : cosω, sinω
+         */
+        inline std::complex< double > clenshaw_response(
+            const double* p,
+            const unsigned int degree,
+            const double c,
+            const double s )
+        {
+            const double x2 = 2.0 * c;
+            double b1 = 0.0;
+            double b2 = 0.0;
+            for ( unsigned int k = degree; k >= 1; --k )
+            {
+                const double b0 = p[k] + x2 * b1 - b2;
+                b2 = b1;
+                b1 = b0;
+            }
+            const double b0 = p[0] + x2 * b1 - b2;
+            return std::complex< double >( b0 - b1 * c, -b1 * s );
+        }
+
+        std::vector< double > expand_sections( const double* coef, unsigned int order );
+
+        /* 周波数掃引の刻み方
+         *   Linear : 線形刻み
+         *   Log : 対数刻み(左端は0より大きいこと)
+         */
+        enum class SweepScale
+        {
+            Linear,
+            Log
+        };
+
+        /* # 周波数掃引の出力先
+         *   各ポインタは呼び出し元が確保した点数分の領域を指す
+         *   nullptrの項目は計算しない
+         *
+         *   response : 周波数特性 H(e^jω)
+         *   magnitude_db : 振幅特性 20log10|H| [dB]
+         *   phase : 位相特性 arg H [rad]
+         *   group_delay : 群遅延特性 [sample]
+         */
+        struct SweepOutput
+        {
+            std::complex< double >* response;
+            double* magnitude_db;
+            double* phase;
+            double* group_delay;
+
+            SweepOutput()
+                : response( nullptr ), magnitude_db( nullptr ), phase( nullptr ),
+                  group_delay( nullptr )
+            {}
+        };
+
+        void gen_sweep_grid(
+            double left,
+            double right,
+            std::size_t count,
+            SweepScale scale,
+            double* freq );
+
+        void sweep_response(
+            unsigned int n_order,
+            unsigned int m_order,
+            const std::vector< double >& coef,
+            const double* freq,
+            std::size_t count,
+            const SweepOutput& out,
+            unsigned int nthreads = 1 );
+
+        void sweep_response(
+            unsigned int n_order,
+            unsigned int m_order,
+            const std::vector< double >& coef,
+            double left,
+            double right,
+            std::size_t count,
+            SweepScale scale,
+            const SweepOutput& out,
+            unsigned int nthreads = 1 );
+
+    }    // namespace iir
+}    // namespace filter
+
+#endif /* FREQ_SWEEP_HPP_ */
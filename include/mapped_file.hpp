@@ -0,0 +1,48 @@
+/*
+ * mapped_file.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef MAPPED_FILE_HPP_
+#define MAPPED_FILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+namespace filter
+{
+    /* # メモリマップしたファイル
+     *   読み取り専用で既存のファイルを開くか，
+     *   指定した大きさで新しく作成して書き込み用に開く
+     *   破棄時にマップを解除する(書き込みはOSが反映する)
+     */
+    struct MappedFile
+    {
+    protected:
+
+        void* addr;
+        std::size_t length;
+
+    public:
+
+        explicit MappedFile( const std::string& path );
+        MappedFile( const std::string& path, std::size_t size );
+        ~MappedFile();
+
+        MappedFile( const MappedFile& ) = delete;
+        MappedFile& operator=( const MappedFile& ) = delete;
+
+        std::size_t size() const { return length; }
+        const char* data() const { return static_cast< const char* >( addr ); }
+        char* data() { return static_cast< char* >( addr ); }
+
+        void advise_sequential() const;
+    };
+
+}    // namespace filter
+
+#endif /* MAPPED_FILE_HPP_ */
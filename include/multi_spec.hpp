@@ -0,0 +1,72 @@
+/*
+ * multi_spec.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef MULTI_SPEC_HPP_
+#define MULTI_SPEC_HPP_
+
+#include "cascade_iir.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace filter
+{
+    namespace iir
+    {
+        /* # 複数の仕様に対する評価結果
+         *   value : 仕様ごとの目的関数値(与えた仕様の順)
+         *   worst : 最悪値(valueの最大値)
+         *   worst_index : 最悪値となった仕様の番号
+         */
+        struct MultiSpecResult
+        {
+            std::vector< double > value;
+            double worst;
+            std::size_t worst_index;
+        };
+
+        /* # 複数の仕様に対する評価
+         *   帯域端や群遅延の異なる仕様の族に対して，1つの係数列を評価する
+         *   全仕様の周波数グリッドを周波数順に並べて統合し，e^-jω, e^-j2ωがビット列で
+         *   一致する点を1点にまとめる
+         *   評価では統合したグリッドの各点で縦続型フィルタの特性を1回だけ計算し，
+         *   各仕様は自身の点の番号から特性を参照して目的関数値を求める
+         *   各仕様の累積の順序・計算式はFilterParam::evaluateと同じため，値は一致する
+         *   (並列掃引・セクション積以外の計算方式の設定は用いない)
+         *
+         *   仕様は構築時にコピーして保持する(表は元の構造体と共有する)
+         *   全仕様の零点・極の数は一致している必要がある
+         */
+        struct MultiSpecEvaluator
+        {
+        protected:
+
+            std::vector< FilterParam > specs;
+            std::vector< std::complex< double > > csw;    // 統合したグリッドのe^-jω
+            std::vector< std::complex< double > > csw2;    // 統合したグリッドのe^-j2ω
+            std::vector< std::vector< std::size_t > > index;    // 仕様の点から統合した点への番号
+
+        public:
+
+            explicit MultiSpecEvaluator( const std::vector< FilterParam >& input_specs );
+            ~MultiSpecEvaluator();
+
+            std::size_t size() const { return specs.size(); }
+            std::size_t unique_points() const { return csw.size(); }
+            std::size_t total_points() const;
+            const FilterParam& spec( std::size_t i ) const { return specs.at( i ); }
+
+            MultiSpecResult evaluate( const std::vector< double >& coef ) const;
+        };
+
+    }    // namespace iir
+}    // namespace filter
+
+#endif /* MULTI_SPEC_HPP_ */
@@ -0,0 +1,73 @@
+/*
+ * parallel_for.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef PARALLEL_FOR_HPP_
+#define PARALLEL_FOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace filter
+{
+    /* 使用するスレッド数を決める
+     *   0を与えた場合はハードウェアのスレッド数(取得できない場合は1)
+     */
+    inline unsigned int resolve_threads( unsigned int nthreads )
+    {
+        if ( nthreads == 0 )
+        {
+            nthreads = std::thread::hardware_concurrency();
+        }
+        return nthreads == 0 ? 1 : nthreads;
+    }
+
+    /* [0, n)を連続した区間に分割して並列に処理する
+     *   区間の分割は要素数とスレッド数のみで決まるため，
+     *   区間ごとの結果を区間番号順に集約すれば結果は実行ごとに変わらない
+     *   区間0は呼び出し元のスレッドで処理する
+     *
+     * # 引数
+     * size_t n : 要素数
+     * unsigned int nthreads : スレッド数(0でハードウェアのスレッド数)
+     * size_t min_chunk : 1区間あたりの最小要素数
+     * Func func : func(begin, end, chunk)の形で呼び出される
+     * # 返り値
+     * size_t nchunk : 分割した区間の数
+     */
+    template< typename Func >
+    std::size_t parallel_for(
+        const std::size_t n,
+        const unsigned int nthreads,
+        const std::size_t min_chunk,
+        Func func )
+    {
+        const std::size_t max_chunk =
+            std::max< std::size_t >( 1, n / std::max< std::size_t >( 1, min_chunk ) );
+        const std::size_t nchunk =
+            std::min< std::size_t >( resolve_threads( nthreads ), max_chunk );
+
+        std::vector< std::thread > workers;
+        workers.reserve( nchunk - 1 );
+        for ( std::size_t t = 1; t < nchunk; ++t )
+        {
+            workers.emplace_back( func, n * t / nchunk, n * ( t + 1 ) / nchunk, t );
+        }
+        func( std::size_t( 0 ), n / nchunk, std::size_t( 0 ) );
+        for ( auto& worker : workers )
+        {
+            worker.join();
+        }
+        return nchunk;
+    }
+
+}    // namespace filter
+
+#endif /* PARALLEL_FOR_HPP_ */
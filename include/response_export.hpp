@@ -0,0 +1,112 @@
+/*
+ * response_export.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef RESPONSE_EXPORT_HPP_
+#define RESPONSE_EXPORT_HPP_
+
+#include "freq_sweep.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace filter
+{
+    namespace iir
+    {
+        /* 出力する特性の種類
+         *   Amplitude : 振幅特性 |H|
+         *   MagnitudeDb : 振幅特性 20log10|H| [dB]
+         *   Phase : 位相特性 [rad]
+         *   GroupDelay : 群遅延特性 [sample]
+         */
+        enum class ExportColumn
+        {
+            Amplitude,
+            MagnitudeDb,
+            Phase,
+            GroupDelay
+        };
+
+        std::size_t write_fixed( double value, unsigned int precision, char* buf );
+        bool render_gnuplot( const std::string& script_path );
+
+        /* # 周波数特性の書き出し
+         *   複数の設計結果の周波数特性を共通の周波数グリッドで計算し，
+         *   1つのファイルにまとめて書き出す
+         *   計算と書き出し・描画を分離するため，描画はgnuplotのスクリプトを
+         *   出力した後にrender_gnuplotで別途行う
+         *   (plotは一時ファイルを介して描画まで行い，画像のみ残す)
+         *
+         *   バイナリ形式(列指向，リトルエンディアンを想定)
+         *     char[8] magic : "FPRESP01"
+         *     uint64 ndesign, npoint, ncolumn
+         *     double freq[npoint]
+         *     double column[ndesign][ncolumn][npoint]
+         *       (列の順はExportColumnの順)
+         */
+        struct ResponseExporter
+        {
+        public:
+
+            static constexpr unsigned int ncolumn = 4;
+
+        protected:
+
+            std::vector< double > freq;
+            unsigned int nthreads;
+            std::vector< std::string > names;
+            std::vector< double > columns;    // [design][column][point]
+
+        public:
+
+            ResponseExporter(
+                double left,
+                double right,
+                std::size_t count,
+                SweepScale scale = SweepScale::Linear,
+                unsigned int input_nthreads = 1 );
+            ~ResponseExporter();
+
+            void add(
+                const std::string& name,
+                unsigned int n_order,
+                unsigned int m_order,
+                const std::vector< double >& coef );
+
+            std::size_t size() const { return names.size(); }
+            std::size_t points() const { return freq.size(); }
+            const std::vector< double >& frequency() const { return freq; }
+            const double* column( std::size_t design, ExportColumn col ) const
+            {
+                return columns.data()
+                       + ( design * ncolumn + static_cast< std::size_t >( col ) )
+                             * freq.size();
+            }
+
+            void write_binary( const std::string& path ) const;
+            void write_csv( const std::string& path ) const;
+            void write_gnuplot(
+                const std::string& data_path,
+                const std::string& script_path,
+                const std::vector< std::string >& images,
+                ExportColumn col ) const;
+            bool plot( const std::vector< std::string >& images, ExportColumn col ) const;
+
+        protected:
+
+            void write_text(
+                const std::string& path, char separator, bool header ) const;
+        };
+
+    }    // namespace iir
+}    // namespace filter
+
+#endif /* RESPONSE_EXPORT_HPP_ */
@@ -0,0 +1,110 @@
+/*
+ * solution_store.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef SOLUTION_STORE_HPP_
+#define SOLUTION_STORE_HPP_
+
+#include "mapped_file.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace filter
+{
+    namespace iir
+    {
+        struct FilterParam;
+
+        /* # 保存した解
+         *   distance : 仕様の距離(SolutionStore::distanceの値)
+         *   value : 保存時の目的関数値
+         *   coef : 係数列
+         */
+        struct StoredSolution
+        {
+            double distance;
+            double value;
+            std::vector< double > coef;
+        };
+
+        /* # 解の保存庫
+         *   最適化で得た係数列を仕様(零点・極の数，帯域，群遅延)と組にしてファイルに追記し，
+         *   近い仕様の解を初期集団の種として取り出す
+         *   ファイルはmmapで読み込み，索引として各記録の位置のみを持つ
+         *   (係数列・帯域はマップした領域を直接参照する)
+         *
+         *   仕様の距離は，零点・極の数と帯域の種類の並びが一致する場合に
+         *     Σ(|左端の差| + |右端の差|) + gd_scale × |群遅延の差|
+         *   とし，一致しない仕様は候補としない
+         *
+         *   バイナリ形式(リトルエンディアンを想定，記録は8byte境界に揃う)
+         *     char[8] magic : "FPSOLS01"
+         *     記録の並び(追記のみ)
+         *       uint32 n_order, m_order, nband, reserved(0)
+         *       double gd, value
+         *       { uint64 type, double left, double right }[nband]
+         *       double coef[1 + n_order + m_order]
+         *   追記はファイルをflockで排他し，他のプロセスが追記した記録を読み直してから
+         *   1回のwriteで行う(複数のジョブが同じファイルに追記してよい)
+         *   書き込みの途中で終わった末尾の記録は読み飛ばし，次の追記の前に排他の下で切り詰める
+         *   追記後はマップし直し，新しい記録のみを索引に加える
+         */
+        struct SolutionStore
+        {
+        protected:
+
+            struct Entry
+            {
+                unsigned int n_order;
+                unsigned int m_order;
+                unsigned int nband;
+                double gd;
+                double value;
+                std::size_t offset;    // 帯域の先頭のファイル内の位置 [byte]
+            };
+
+            std::string path;
+            double gd_scale;
+            std::unique_ptr< MappedFile > file;
+            std::vector< Entry > entries;
+            std::size_t valid_bytes;    // 最後の完全な記録の終端 [byte]
+
+            void remap();
+            void index_records( std::size_t pos );
+            void reload();
+            const double* band_data( const Entry& entry ) const;
+            const double* coef_data( const Entry& entry ) const;
+
+        public:
+
+            static constexpr std::size_t header_bytes = 8;
+
+            explicit SolutionStore( const std::string& input_path, double input_gd_scale = 0.01 );
+            ~SolutionStore();
+
+            std::size_t size() const { return entries.size(); }
+
+            void add( const FilterParam& param, const std::vector< double >& coef, double value );
+            double distance( const FilterParam& param, std::size_t index ) const;
+            std::vector< StoredSolution >
+            nearest( const FilterParam& param, std::size_t count ) const;
+            std::vector< std::vector< double > > seed_population(
+                const FilterParam& param,
+                std::size_t size,
+                double jitter,
+                double a0,
+                double a ) const;
+        };
+
+    }    // namespace iir
+}    // namespace filter
+
+#endif /* SOLUTION_STORE_HPP_ */
@@ -0,0 +1,146 @@
+/*
+ * surrogate.hpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * This cord is written by UTF-8
+ */
+
+#ifndef SURROGATE_HPP_
+#define SURROGATE_HPP_
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace filter
+{
+    namespace iir
+    {
+        struct FilterParam;
+
+        /* # 代理モデルによる選別の設定
+         *   capacity : 保持する(係数列, 目的関数値)の組の最大数(古いものから置き換える)
+         *   neighbors : 予測に用いる近傍の数
+         *   fraction : 1世代のうち本評価する候補の割合(予測値の良い順，最低1個)
+         *   min_archive : 予測を始める組の数(これ未満の間は全候補を本評価する)
+         *   eval_budget : 本評価の総数の上限(0で無制限)
+         *   audit : 1世代あたり，選ばれなかった候補から無作為に選んで本評価する数
+         *           (統計の偏りを除くため．本評価の残りの回数の範囲で行い，上限に数える)
+         */
+        struct SurrogateConfig
+        {
+            std::size_t capacity;
+            unsigned int neighbors;
+            double fraction;
+            std::size_t min_archive;
+            std::size_t eval_budget;
+            std::size_t audit;
+
+            SurrogateConfig()
+                : capacity( 512 ), neighbors( 8 ), fraction( 0.25 ), min_archive( 16 ),
+                  eval_budget( 0 ), audit( 2 )
+            {}
+        };
+
+        /* # 代理モデルによる選別の統計
+         *   ncandidate : 選別した候補の総数
+         *   nevaluated : 本評価した候補の数(naudited を含む)
+         *   npredicted : 予測値のみ返した候補の数
+         *   naudited : 選ばれなかった候補から無作為に選んで本評価した数
+         *   npair, nconcordant : 同じ世代で予測した後に本評価した候補の組の数と，
+         *                        そのうち予測値と本評価の大小関係が一致した組の数
+         *   relative_error : 予測した後に本評価した候補の予測値の相対誤差の和
+         *   nchecked : relative_errorを累積した候補の数
+         *
+         *   統計は本評価した候補のみから求めるため，選ばれた候補の条件付きの値となる
+         *   SurrogateConfig::auditの候補を含めることで選別の境界をまたぐ組が入るが，
+         *   それでも全候補の一様な標本ではない(audit = 0では上位の候補間の順位のみを見る)
+         *   concordance()は0.5が無作為な順位付けに当たる
+         */
+        struct SurrogateStats
+        {
+            std::size_t ncandidate;
+            std::size_t nevaluated;
+            std::size_t npredicted;
+            std::size_t naudited;
+            std::size_t npair;
+            std::size_t nconcordant;
+            double relative_error;
+            std::size_t nchecked;
+
+            SurrogateStats()
+                : ncandidate( 0 ), nevaluated( 0 ), npredicted( 0 ), naudited( 0 ), npair( 0 ),
+                  nconcordant( 0 ), relative_error( 0.0 ), nchecked( 0 )
+            {}
+
+            // 予測値の大小関係が一致した割合(組が無い場合は0)
+            double concordance() const
+            {
+                return npair == 0 ? 0.0
+                                  : static_cast< double >( nconcordant )
+                                        / static_cast< double >( npair );
+            }
+            double mean_relative_error() const
+            {
+                return nchecked == 0 ? 0.0 : relative_error / static_cast< double >( nchecked );
+            }
+        };
+
+        /* # 代理モデルによる選別の結果
+         *   value : 候補ごとの目的関数値(本評価しなかった候補は予測値)
+         *   evaluated : 本評価した候補はtrue
+         */
+        struct ScreenResult
+        {
+            std::vector< double > value;
+            std::vector< bool > evaluated;
+
+            ScreenResult();
+            ScreenResult( const ScreenResult& );
+            ScreenResult( ScreenResult&& ) noexcept;
+            ScreenResult& operator=( const ScreenResult& );
+            ScreenResult& operator=( ScreenResult&& ) noexcept;
+            ~ScreenResult();
+        };
+
+        /* # 代理モデルによる選別
+         *   最近の(係数列, 目的関数値)の組を保持し，候補の目的関数値を
+         *   k近傍の逆距離加重平均(距離の2乗の逆数で重み付け)で予測する
+         *   1世代の候補を予測値で順位付けし，良い方の一部のみFilterParam::evaluate_batchで
+         *   本評価して，その結果を組に加える(組の追加は古いものを置き換えるのみで，
+         *   モデルの再構築は無い)
+         *   監査の候補は既定の種から始める乱数で選ぶため，同じ候補の列からは同じ結果となる
+         */
+        struct SurrogateScreen
+        {
+        protected:
+
+            SurrogateConfig config;
+            SurrogateStats stats;
+            std::size_t dimension;
+            std::vector< double > archive_coef;    // [組][係数]
+            std::vector< double > archive_value;
+            std::size_t next;    // 次に置き換える組
+            std::mt19937 rng;    // 監査の候補の選択に用いる
+
+        public:
+
+            explicit SurrogateScreen( const SurrogateConfig& input_config = SurrogateConfig() );
+            ~SurrogateScreen();
+
+            std::size_t archive_size() const { return archive_value.size(); }
+            const SurrogateStats& statistics() const { return stats; }
+            std::size_t remaining_budget() const;
+
+            void add( const std::vector< double >& coef, double value );
+            double predict( const std::vector< double >& coef ) const;
+            ScreenResult
+            screen( const FilterParam& param, const std::vector< std::vector< double > >& trials );
+        };
+
+    }    // namespace iir
+}    // namespace filter
+
+#endif /* SURROGATE_HPP_ */
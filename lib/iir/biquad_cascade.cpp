@@ -0,0 +1,178 @@
+/*
+ * biquad_cascade.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#include "biquad_cascade.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace filter
+{
+    namespace iir
+    {
+        namespace
+        {
+            // 分子・分母の一方のセクションの係数を(c1, c2)の列に並べる
+            void push_sections(
+                const double* c,
+                unsigned int order,
+                std::vector< double >& c1,
+                std::vector< double >& c2 )
+            {
+                const unsigned int odd = order % 2;
+                if ( odd == 1 )
+                {
+                    c1.emplace_back( c[0] );
+                    c2.emplace_back( 0.0 );
+                }
+                for ( unsigned int k = odd; k < order; k += 2 )
+                {
+                    c1.emplace_back( c[k] );
+                    c2.emplace_back( c[k + 1] );
+                }
+            }
+        }    // namespace
+
+        /* # 縦続型IIRフィルタの実行系
+         *
+         * # 引数
+         * unsigned int n_order, m_order : 分子・分母の次数
+         * vector<double>& coef : 係数列(a0, a1, a2[0], a2[1],..., b1, b2[0], b2[1],...)
+         * unsigned int input_nchannel : チャネル数(1以上)
+         */
+        BiquadCascade::BiquadCascade(
+            unsigned int n_order,
+            unsigned int m_order,
+            const std::vector< double >& coef,
+            unsigned int input_nchannel )
+            : nchannel( input_nchannel ), gain( 0.0 )
+        {
+            if ( coef.size() != 1 + n_order + m_order || nchannel == 0 )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Size of coefficients or number of channels is "
+                    "illegal.(size : %llu, expected : %u, channels : %u)\n",
+                    __FILE__, __LINE__, static_cast< unsigned long long >( coef.size() ),
+                    1 + n_order + m_order, nchannel );
+                exit( EXIT_FAILURE );
+            }
+
+            gain = coef[0];
+            push_sections( coef.data() + 1, n_order, nume1, nume2 );
+            push_sections( coef.data() + 1 + n_order, m_order, deno1, deno2 );
+
+            const std::size_t nsection = std::max( nume1.size(), deno1.size() );
+            nume1.resize( nsection, 0.0 );
+            nume2.resize( nsection, 0.0 );
+            deno1.resize( nsection, 0.0 );
+            deno2.resize( nsection, 0.0 );
+            state.assign( 2 * nsection * nchannel, 0.0 );
+        }
+
+        BiquadCascade::~BiquadCascade() = default;
+
+        // 内部状態を0に戻す
+        void BiquadCascade::reset() { std::fill( state.begin(), state.end(), 0.0 ); }
+
+        /* # 縦続型IIRフィルタの実行系
+         *   nframeフレーム分の信号をフィルタリングする
+         *   チャネルをlane_block個ずつに分け，各組をセクション順に処理する
+         *   inputとoutputは同じ領域でもよい
+         *
+         * # 引数
+         * double* input : 入力信号[frame][channel]
+         * double* output : 出力信号[frame][channel]
+         * size_t nframe : フレーム数
+         */
+        void BiquadCascade::process( const double* input, double* output, std::size_t nframe )
+        {
+            std::size_t c0 = 0;
+            for ( ; c0 + lane_block <= nchannel; c0 += lane_block )
+            {
+                process_lanes< lane_block >( input, output, nframe, c0 );
+            }
+            for ( ; c0 < nchannel; ++c0 )
+            {
+                process_lanes< 1 >( input, output, nframe, c0 );
+            }
+        }
+
+        /* # 縦続型IIRフィルタの実行系
+         *   チャネルchannelからLanes個のチャネルを処理する
+         *   セクションごとにブロック全体を通し，セクションの状態は
+         *   ブロックの間レジスタ(局所配列)に置く
+         *   2段目以降はoutputを入力として上書きする
+         */
+        template< std::size_t Lanes >
+        void BiquadCascade::process_lanes(
+            const double* input,
+            double* output,
+            std::size_t nframe,
+            std::size_t channel )
+        {
+            const std::size_t nsection = sections();
+            const std::size_t stride = nchannel;
+
+            if ( nsection == 0 )
+            {
+                for ( std::size_t t = 0; t < nframe; ++t )
+                {
+                    const double* x = input + t * stride + channel;
+                    double* y = output + t * stride + channel;
+                    for ( std::size_t l = 0; l < Lanes; ++l )
+                    {
+                        y[l] = gain * x[l];
+                    }
+                }
+                return;
+            }
+
+            for ( std::size_t s = 0; s < nsection; ++s )
+            {
+                const double n1 = nume1[s];
+                const double n2 = nume2[s];
+                const double d1 = deno1[s];
+                const double d2 = deno2[s];
+                const double in_gain = s == 0 ? gain : 1.0;
+                const double* src = s == 0 ? input : output;
+                double* z1 = state.data() + ( 2 * s ) * stride + channel;
+                double* z2 = state.data() + ( 2 * s + 1 ) * stride + channel;
+
+                double s1[Lanes], s2[Lanes];
+                for ( std::size_t l = 0; l < Lanes; ++l )
+                {
+                    s1[l] = z1[l];
+                    s2[l] = z2[l];
+                }
+
+                for ( std::size_t t = 0; t < nframe; ++t )
+                {
+                    const double* x = src + t * stride + channel;
+                    double* y = output + t * stride + channel;
+                    for ( std::size_t l = 0; l < Lanes; ++l )
+                    {
+                        const double xin = in_gain * x[l];
+                        const double yout = xin + s1[l];
+                        s1[l] = n1 * xin - d1 * yout + s2[l];
+                        s2[l] = n2 * xin - d2 * yout;
+                        y[l] = yout;
+                    }
+                }
+
+                for ( std::size_t l = 0; l < Lanes; ++l )
+                {
+                    z1[l] = s1[l];
+                    z2[l] = s2[l];
+                }
+            }
+        }
+
+    }    // namespace iir
+}    // namespace filter
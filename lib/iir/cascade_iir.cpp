@@ -7,6 +7,8 @@
 
 #include "cascade_iir.hpp"
 
+#include <unistd.h>
+
 
 namespace filter
 {
@@ -17,7 +19,8 @@ namespace filter
         const std::string& call_file,
         const int call_line )
     {
-        FILE* fp = fopen( filename.c_str(), &mode );
+        const char mode_str[] = { mode, '\0' };
+        FILE* fp = fopen( filename.c_str(), mode_str );
         if ( fp == NULL )
         {
             fprintf(
@@ -41,9 +44,73 @@ namespace filter
         return strs;
     }
 
+    /* 2次セクション(1 + c1 z^-1 + c2 z^-2)の根を分岐なしで計算する
+     *   判別式の符号による実数解・複素解の選択を三項演算子の
+     *   マスクで表すため，ループはベクトル化できる
+     *   重解も2つの根として出力するため，出力は常に2 * nsec個
+     *
+     * # 引数
+     * double* sec : セクションの係数(c1, c2, c1, c2, ...)
+     * unsigned int nsec : セクション数
+     * double* re, im : 根の実部・虚部の出力先
+     */
+    static void solve_sections(
+        const double* sec,
+        const unsigned int nsec,
+        double* re,
+        double* im )
+    {
+        for ( unsigned int s = 0; s < nsec; ++s )
+        {
+            const double c1 = sec[2 * s];
+            const double c2 = sec[2 * s + 1];
+            const double disc = c1 * c1 - 4.0 * c2;
+            const double root = 0.5 * std::sqrt( std::abs( disc ) );
+            const double cplx = disc < 0.0 ? 1.0 : 0.0;    // 複素解のマスク
+            const double real = ( 1.0 - cplx ) * root;
+
+            re[2 * s] = -0.5 * c1 + real;
+            re[2 * s + 1] = -0.5 * c1 - real;
+            im[2 * s] = cplx * root;
+            im[2 * s + 1] = -cplx * root;
+        }
+    }
+
     namespace iir
     {
 
+        /* # 一括評価のタイル寸法
+         *   データキャッシュの容量からタイル寸法を決める
+         *   取得できない環境ではL1 32KiB, L2 256KiBとみなす
+         *   どちらも半分を作業領域の目安とする
+         *
+         * # 引数
+         * unsigned int opt_order : 1候補あたりの係数の数
+         */
+        TileConfig TileConfig::detect( unsigned int opt_order )
+        {
+            long l1 = -1;
+            long l2 = -1;
+#if defined( _SC_LEVEL1_DCACHE_SIZE ) && defined( _SC_LEVEL2_CACHE_SIZE )
+            l1 = sysconf( _SC_LEVEL1_DCACHE_SIZE );
+            l2 = sysconf( _SC_LEVEL2_CACHE_SIZE );
+#endif
+            const std::size_t l1_size =
+                l1 > 0 ? static_cast< std::size_t >( l1 ) : 32 * 1024;
+            const std::size_t l2_size =
+                l2 > 0 ? static_cast< std::size_t >( l2 ) : 256 * 1024;
+
+            // 1点あたり e^-jω, e^-j2ω, 所望特性の3つの複素数
+            const std::size_t point_bytes = 3 * sizeof( std::complex< double > );
+            // 1候補あたり 係数列と最大誤差・最大隆起
+            const std::size_t cand_bytes = ( opt_order + 2 ) * sizeof( double );
+
+            TileConfig config;
+            config.freq_block = std::max< std::size_t >( 16, l1_size / 2 / point_bytes );
+            config.cand_tile = std::max< std::size_t >( 1, l2_size / 2 / cand_bytes );
+            return config;
+        }
+
         /* # フィルタ構造体
          *   FilterParamという構造体でメンバ変数を()内で初期化、これらの情報を基に
          *   ・帯域の種類ごとに分割数を算出
@@ -60,6 +127,7 @@ namespace filter
          * unsigned int input_nsplit_approx : 近似域の分割数
          * unsigned int input_nsplit_transition : 遷移域の分割数
          * double gd : 所望群遅延
+         * ObjectiveConfig& input_objective : 目的関数の設定(省略時は重み100, 最大誤差)
          */
         FilterParam::FilterParam(
             unsigned int zero,
@@ -67,8 +135,9 @@ namespace filter
             BandParam input_band,
             unsigned int input_nsplit_approx,
             unsigned int input_nsplit_transition,
-            double gd )
-            : FilterParam( zero, pole, std::vector< BandParam > { input_band }, input_nsplit_approx, input_nsplit_transition, gd )
+            double gd,
+            const ObjectiveConfig& input_objective )
+            : FilterParam( zero, pole, std::vector< BandParam > { input_band }, input_nsplit_approx, input_nsplit_transition, gd, input_objective )
         {}
 
         FilterParam::FilterParam(
@@ -77,11 +146,13 @@ namespace filter
             std::vector< BandParam > input_bands,
             unsigned int input_nsplit_approx,
             unsigned int input_nsplit_transition,
-            double gd )
-            : n_order( zero ), m_order( pole ), bands( input_bands ),
+            double gd,
+            const ObjectiveConfig& input_objective )
+            : n_order( zero ), m_order( pole ), bands( std::move( input_bands ) ),
               nsplit_approx( input_nsplit_approx ),
               nsplit_transition( input_nsplit_transition ), group_delay( gd ),
-              threshold_riple( 1.0 )
+              threshold_riple( 1.0 ), sweep_threads( 1 ),
+              engine( ResponseEngine::SectionProduct ), riple_bound( true )
         {
             using std::vector;
             const double acc = 1.0e-10;    // 1.0×10^-10≒0
@@ -90,7 +161,7 @@ namespace filter
             if ( 2 <= this->bands.size() )
             {
                 double band_left = 0.0;
-                for ( auto bp : bands )
+                for ( const auto& bp : bands )
                 {
                     if ( std::abs( bp.left() - band_left ) > acc )
                     {
@@ -100,7 +171,7 @@ namespace filter
                             "same.\n"
                             "Or first band of left side must be 0.0.\n",
                             __FILE__, __LINE__ );
-                        for ( auto bp_ : bands )
+                        for ( auto& bp_ : bands )
                         {
                             fprintf( stderr, "%s\n", bp_.sprint().c_str() );
                         }
@@ -114,7 +185,7 @@ namespace filter
                         stderr,
                         "Error: [%s l.%d]Last band of right side must be 0.5.\n",
                         __FILE__, __LINE__ );
-                    for ( auto bp : bands )
+                    for ( auto& bp : bands )
                     {
                         fprintf( stderr, "%s\n", bp.sprint().c_str() );
                     }
@@ -126,7 +197,7 @@ namespace filter
             double approx_range = 0.0;
             double transition_range = 0.0;
 
-            for ( auto bp : bands )
+            for ( const auto& bp : bands )
             {
                 switch ( bp.type() )
                 {
@@ -157,7 +228,7 @@ namespace filter
 
             vector< unsigned int > split;
             split.reserve( bands.size() );
-            for ( auto bp : bands )
+            for ( const auto& bp : bands )
             {
                 switch ( bp.type() )
                 {
@@ -195,56 +266,139 @@ namespace filter
 
             // generate complex sin wave(e^-jω)
             // desire frequency response
-            csw.reserve( bands.size() );
-            csw2.reserve( bands.size() );
-            desire_res.reserve( bands.size() );
+            vector< std::size_t > split_desire( bands.size() );
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                split_desire[i] = bands[i].type() == BandType::Transition ? 0 : split[i];
+            }
+            auto new_grid = std::make_shared< GridTable >(
+                vector< std::size_t >( split.begin(), split.end() ), 2 );
+            auto new_desire = std::make_shared< GridTable >( split_desire, 1 );
             for ( unsigned int i = 0; i < bands.size(); ++i )
             {
-                csw.emplace_back( gen_csw( bands.at( i ), split.at( i ) ) );
-                csw2.emplace_back( gen_csw2( bands.at( i ), split.at( i ) ) );
-                desire_res.emplace_back( gen_desire_res(
-                    bands.at( i ), split.at( i ), group_delay ) );
+                gen_tables(
+                    bands[i], split[i], group_delay,
+                    new_grid->plane_data( 0 ) + new_grid->offset[i],
+                    new_grid->plane_data( 1 ) + new_grid->offset[i],
+                    new_desire->plane_data( 0 ) + new_desire->offset[i] );
             }
+            bind_grid( std::move( new_grid ), std::move( new_desire ) );
+            setup_evaluation( input_objective );
+        }
 
-            // decide using function
-            if ( ( n_order % 2 ) == 0 )
+        /* # フィルタ構造体
+         *   表形式の所望特性ファイル(desire_spec.hpp)から構築する
+         *   ファイルをmmapし，周波数・振幅・位相・重みの列を1回ずつ読みながら
+         *   e^-jω, e^-j2ω, 所望特性の表へ直接書き込む
+         *   全点を1つの近似帯域(通過域)として扱い，所望特性は
+         *   |D| e^j(phase - 2πf*gd)，点ごとの重みは目的関数の重みに掛け合わせる
+         *
+         * # 引数
+         * unsigned int zero : 零点の数
+         * unsigned int pole : 極の数
+         * string& spec_path : 所望特性ファイルのパス
+         * double gd : 所望群遅延
+         * ObjectiveConfig& input_objective : 目的関数の設定
+         */
+        FilterParam::FilterParam(
+            unsigned int zero,
+            unsigned int pole,
+            const std::string& spec_path,
+            double gd,
+            const ObjectiveConfig& input_objective )
+            : FilterParam()
+        {
+            constexpr double dpi = -2.0 * M_PI;    // double pi
+
+            n_order = zero;
+            m_order = pole;
+            group_delay = gd;
+
+            const MappedSpec spec( spec_path );
+            const std::size_t npoint = spec.size();
+            const double* freq = spec.freq();
+            const double* magnitude = spec.magnitude();
+            const double* phase = spec.phase();
+            const double* weight = spec.weight();
+
+            auto new_grid =
+                std::make_shared< GridTable >( std::vector< std::size_t > { npoint }, 2 );
+            auto new_desire =
+                std::make_shared< GridTable >( std::vector< std::size_t > { npoint }, 1 );
+            auto new_spec = std::make_shared< SpecTable >();
+            new_spec->freq.resize( npoint );
+            new_spec->weight.resize( npoint );
+            new_spec->magnitude.assign( magnitude, magnitude + npoint );
+            new_spec->phase.assign( phase, phase + npoint );
+            std::complex< double >* csw_out = new_grid->plane_data( 0 );
+            std::complex< double >* csw2_out = new_grid->plane_data( 1 );
+            std::complex< double >* desire_out = new_desire->plane_data( 0 );
+
+            for ( std::size_t k = 0; k < npoint; ++k )
             {
-                if ( ( m_order % 2 ) == 0 )
+                const double f = freq[k];
+                if ( !( f >= 0.0 && f <= 0.5 ) || ( k != 0 && f < freq[k - 1] )
+                     || !( weight[k] >= 0.0 ) || !std::isfinite( magnitude[k] )
+                     || !std::isfinite( phase[k] ) )
                 {
-                    this->freq_res_func = &FilterParam::freq_res_se;
-                    this->group_delay_func = &FilterParam::group_delay_se;
-                    this->stability_func = &FilterParam::judge_stability_even;
-                    this->pole_func = &FilterParam::pole_even;
-                    this->zero_func = &FilterParam::zero_even;
-                }
-                else
-                {
-                    this->freq_res_func = &FilterParam::freq_res_mo;
-                    this->group_delay_func = &FilterParam::group_delay_mo;
-                    this->stability_func = &FilterParam::judge_stability_odd;
-                    this->pole_func = &FilterParam::pole_even;
-                    this->zero_func = &FilterParam::zero_odd;
+                    fprintf(
+                        stderr,
+                        "Error: [%s l.%d]Spec point is illegal.(file name : %s, index : "
+                        "%llu, freq : %f, weight : %f)\n"
+                        "Frequency must be ascending in [0, 0.5] and weight must be "
+                        "non-negative.\n",
+                        __FILE__, __LINE__, spec_path.c_str(),
+                        static_cast< unsigned long long >( k ), f, weight[k] );
+                    exit( EXIT_FAILURE );
                 }
+
+                const double re = std::cos( dpi * f );
+                const double im = std::sin( dpi * f );
+                csw_out[k] = std::complex< double >( re, im );
+                csw2_out[k] = std::complex< double >( re * re - im * im, 2.0 * re * im );
+                desire_out[k] = magnitude[k] * std::polar( 1.0, phase[k] + dpi * gd * f );
+                new_spec->freq[k] = f;
+                new_spec->weight[k] = weight[k];
+            }
+
+            bands.emplace_back( BandType::Pass, freq[0], freq[npoint - 1] );
+            nsplit_approx = static_cast< unsigned int >( npoint );
+            nsplit_transition = 0;
+            spec_table = std::move( new_spec );
+            bind_grid( std::move( new_grid ), std::move( new_desire ) );
+            setup_evaluation( input_objective );
+        }
+
+        RootBuffer::RootBuffer( const RootBuffer& ) = default;
+        RootBuffer::RootBuffer( RootBuffer&& ) noexcept = default;
+        RootBuffer& RootBuffer::operator=( const RootBuffer& ) = default;
+        RootBuffer& RootBuffer::operator=( RootBuffer&& ) noexcept = default;
+        RootBuffer::~RootBuffer() = default;
+
+        FilterParam::FilterParam( const FilterParam& ) = default;
+        FilterParam::FilterParam( FilterParam&& ) noexcept = default;
+        FilterParam& FilterParam::operator=( const FilterParam& ) = default;
+        FilterParam& FilterParam::operator=( FilterParam&& ) noexcept = default;
+        FilterParam::~FilterParam() = default;
+
+        /* # フィルタ構造体
+         *   周波数グリッドの表を設定した後の共通の初期化
+         *   タイル寸法・目的関数の重みの表・次数の偶奇の組を決める
+         */
+        void FilterParam::setup_evaluation( const ObjectiveConfig& input_objective )
+        {
+            tile_config = TileConfig::detect( opt_order() );
+
+            // decide using function
+            if ( ( n_order % 2 ) == 0 )
+            {
+                parity = ( m_order % 2 ) == 0 ? OrderParity::SE : OrderParity::MO;
             }
             else
             {
-                if ( ( m_order % 2 ) == 0 )
-                {
-                    this->freq_res_func = &FilterParam::freq_res_no;
-                    this->group_delay_func = &FilterParam::group_delay_no;
-                    this->stability_func = &FilterParam::judge_stability_even;
-                    this->pole_func = &FilterParam::pole_odd;
-                    this->zero_func = &FilterParam::zero_even;
-                }
-                else
-                {
-                    this->freq_res_func = &FilterParam::freq_res_so;
-                    this->group_delay_func = &FilterParam::group_delay_so;
-                    this->stability_func = &FilterParam::judge_stability_odd;
-                    this->pole_func = &FilterParam::pole_odd;
-                    this->zero_func = &FilterParam::zero_odd;
-                }
+                parity = ( m_order % 2 ) == 0 ? OrderParity::NO : OrderParity::SO;
             }
+            set_objective( input_objective );
         }
 
         /* # フィルタ構造体
@@ -256,6 +410,8 @@ namespace filter
          * NsplitTransition No : 所望特性のナンバリング Numerator : 分子次数
          *         Denominator : 分母次数
          *         State : フィルタの特性情報(L.P.F.など)
+         *                 Other(path)の場合は表形式の所望特性ファイルを読み込み，
+         *                 NsplitApprox, NsplitTransitionは用いない
          *         GroupDelay : 所望群遅延
          *         NsplitApprox : 近似帯域の分割数
          *         NsplitTransition : 遷移域の分割数
@@ -316,10 +472,19 @@ namespace filter
                                 FilterType::LPF, edges.at( 0 ), edges.at( 1 ) );
                             break;
                         }
+                    case FilterType::Other:
+                        {
+                            // 分割数の列は用いず，ファイルの周波数点をそのまま用いる
+                            filter_params.emplace_back(
+                                static_cast< unsigned int >( atoi( vals.at( 1 ).c_str() ) ),
+                                static_cast< unsigned int >( atoi( vals.at( 2 ).c_str() ) ),
+                                FilterParam::analyze_spec_path( vals.at( 3 ) ),
+                                atof( vals.at( 4 ).c_str() ) );
+                            continue;
+                        }
                     case FilterType::HPF:
                     case FilterType::BPF:
                     case FilterType::BEF:
-                    case FilterType::Other:
                     default:
                         {
                             fprintf(
@@ -331,15 +496,15 @@ namespace filter
                         }
                 }
 
-                filter_params.emplace_back( FilterParam(
+                filter_params.emplace_back(
                     static_cast< unsigned int >( atoi( vals.at( 1 ).c_str() ) ),
                     static_cast< unsigned int >( atoi( vals.at( 2 ).c_str() ) ),
-                    bands,
+                    std::move( bands ),
                     static_cast< unsigned int >(
                         ( atoi( vals.at( 5 ).c_str() ) ) ),
                     static_cast< unsigned int >(
                         ( atoi( vals.at( 6 ).c_str() ) ) ),
-                    atof( vals.at( 4 ).c_str() ) ) );
+                    atof( vals.at( 4 ).c_str() ) );
             }
 
             return filter_params;
@@ -349,7 +514,7 @@ namespace filter
          *   LPF(0.2, 0.3) : L.P.F.で通過域端 0.2, 阻止域端 0.3のフィルタ
          *
          *   Other(path) :
-         * その他の特性のフィルタ。pathは周波数帯域の情報を記したファイルへの相対パス
+         * その他の特性のフィルタ。pathは表形式の所望特性ファイル(desire_spec.hpp)への相対パス
          */
         FilterType FilterParam::analyze_type( const std::string& input )
         {
@@ -386,6 +551,10 @@ namespace filter
             {
                 type = FilterType::LPF;
             }
+            else if ( input_type.at( 0 ) == "Other" )
+            {
+                type = FilterType::Other;
+            }
             else if ( true )    // hpf, bpf, bef バリエーション
             {
                 fprintf(
@@ -458,6 +627,295 @@ namespace filter
             return edge;
         }
 
+        /* # フィルタ構造体
+         *   Other(path)の形式の文字列から所望特性ファイルのパスを取り出す
+         *   パスの前後の空白は取り除く
+         *
+         * # 引数
+         * string& input : 解析する文字列
+         * # 返り値
+         * string path : 所望特性ファイルのパス
+         */
+        std::string FilterParam::analyze_spec_path( const std::string& input )
+        {
+            const std::size_t open = input.find( '(' );
+            const std::size_t close = input.rfind( ')' );
+            if ( open == std::string::npos || close == std::string::npos || close <= open + 1 )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Format of filter state is illegal.(input "
+                    ": \"%s\")\n",
+                    __FILE__, __LINE__, input.c_str() );
+                exit( EXIT_FAILURE );
+            }
+
+            const std::string path = input.substr( open + 1, close - open - 1 );
+            const std::size_t first = path.find_first_not_of( ' ' );
+            const std::size_t last = path.find_last_not_of( ' ' );
+            return first == std::string::npos ? std::string()
+                                              : path.substr( first, last - first + 1 );
+        }
+
+        namespace
+        {
+            constexpr std::size_t rotation_block = 64;    // 再アンカーの間隔(点数)
+
+            /* 等間隔の角度 start + step*k (k = 0..n-1) の複素正弦波を生成する
+             *   ブロック先頭の値(アンカー)のみ三角関数で求め，ブロック内は
+             *   回転子 e^j(step*k) の表を掛けて進める
+             *   ブロックごとにアンカーを取り直すため誤差は蓄積せず，数ulpに収まる
+             *   ブロック内のループは実数演算のみで依存関係が無く，ベクトル化できる
+             */
+            void gen_rotation(
+                const double start,
+                const double step,
+                const std::size_t n,
+                std::complex< double >* out )
+            {
+                double pr[rotation_block], pi[rotation_block];
+                const std::size_t len = std::min( n, rotation_block );
+                for ( std::size_t k = 0; k < len; ++k )
+                {
+                    pr[k] = std::cos( step * static_cast< double >( k ) );
+                    pi[k] = std::sin( step * static_cast< double >( k ) );
+                }
+
+                for ( std::size_t k0 = 0; k0 < n; k0 += rotation_block )
+                {
+                    const double ang = start + step * static_cast< double >( k0 );
+                    const double ar = std::cos( ang );
+                    const double ai = std::sin( ang );
+                    const std::size_t m = std::min( rotation_block, n - k0 );
+                    for ( std::size_t k = 0; k < m; ++k )
+                    {
+                        out[k0 + k] = std::complex< double >(
+                            ar * pr[k] - ai * pi[k], ar * pi[k] + ai * pr[k] );
+                    }
+                }
+            }
+        }    // namespace
+
+        /* # フィルタ構造体
+         *   1つの周波数帯域の表(e^-jω, e^-j2ω, 所望特性)をまとめて生成する関数
+         *   e^-jωは回転子による漸化式(ブロックごとに再アンカー)で求め，
+         *   e^-j2ωはその2乗とする
+         *   通過域の所望特性 e^-jωτ も同じ方法で求めるため，
+         *   三角関数の呼び出しは点数の1/64程度で済む
+         *   出力先は呼び出し元が確保し，desireは遷移域の場合は書き込まない
+         *
+         * # 引数
+         * BandParam& bp : 周波数帯域情報をもった構造体
+         * unsigned int nsplit : 周波数帯域の分割数
+         * double group_delay : 所望群遅延
+         * complex<double>* csw : e^-jωの出力先(nsplit点)
+         * complex<double>* csw2 : e^-j2ωの出力先(nsplit点)
+         * complex<double>* desire : 所望特性の出力先(nsplit点，遷移域は参照しない)
+         *   いずれもnullptrの場合はその表を生成しない
+         *   (cswのみnullptrの場合はcsw2の領域にe^-jωを求めてからその場で2乗するため，
+         *    値はcswと組で生成した場合と一致する)
+         */
+        void FilterParam::gen_tables(
+            const BandParam& bp,
+            const unsigned int nsplit,
+            const double group_delay,
+            std::complex< double >* csw,
+            std::complex< double >* csw2,
+            std::complex< double >* desire )
+        {
+            constexpr double dpi = -2.0 * M_PI;    // double pi
+            const double step_size = bp.width() / static_cast< double >( nsplit );
+            const double left = bp.left();
+
+            std::complex< double >* rotation = csw != nullptr ? csw : csw2;
+            if ( rotation != nullptr )
+            {
+                gen_rotation( dpi * left, dpi * step_size, nsplit, rotation );
+            }
+            if ( csw2 != nullptr )
+            {
+                for ( unsigned int i = 0; i < nsplit; ++i )
+                {
+                    const double re = rotation[i].real();
+                    const double im = rotation[i].imag();
+                    csw2[i] = std::complex< double >( re * re - im * im, 2.0 * re * im );
+                }
+            }
+            if ( desire == nullptr )
+            {
+                return;
+            }
+
+            switch ( bp.type() )
+            {
+                case BandType::Pass:
+                    gen_rotation(
+                        dpi * group_delay * left, dpi * group_delay * step_size, nsplit,
+                        desire );
+                    break;
+                case BandType::Stop:
+                    std::fill( desire, desire + nsplit, std::complex< double >( 0.0, 0.0 ) );
+                    break;
+                case BandType::Transition: break;
+                default:
+                    {
+                        fprintf(
+                            stderr, "Error: [%s l.%d]Undefined band.\n", __FILE__,
+                            __LINE__ );
+                        exit( EXIT_FAILURE );
+                    }
+            }
+        }
+
+        /* # フィルタ構造体
+         *   周波数グリッドの表を設定し，帯域別の参照を作り直す
+         *
+         * # 引数
+         * shared_ptr<const GridTable> input_grid : e^-jω, e^-j2ωの表(2面)
+         * shared_ptr<const GridTable> input_desire : 所望特性の表
+         * size_t desire_plane : 参照する所望特性の面(retarget_batchでは目標ごとに異なる)
+         */
+        void FilterParam::bind_grid(
+            std::shared_ptr< const GridTable > input_grid,
+            std::shared_ptr< const GridTable > input_desire,
+            std::size_t desire_plane )
+        {
+            grid_table = std::move( input_grid );
+            desire_table = std::move( input_desire );
+            csw = grid_table->plane( 0 );
+            csw2 = grid_table->plane( 1 );
+            desire_res = desire_table->plane( desire_plane );
+        }
+
+        /* # フィルタ構造体
+         *   群遅延gdの所望特性を，現在の所望特性の表と同じ並びで書き込む
+         *   構築時と同じ計算を行うため，同じ群遅延で構築した場合と値が一致する
+         *
+         * # 引数
+         * double gd : 所望群遅延
+         * complex<double>* desire : 出力先(desire_table->npoint()点)
+         */
+        void FilterParam::fill_desire( double gd, std::complex< double >* desire ) const
+        {
+            constexpr double dpi = -2.0 * M_PI;    // double pi
+
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                std::complex< double >* out = desire + desire_table->offset[i];
+                const std::size_t npoint = desire_res[i].size();
+                if ( spec_table )
+                {
+                    const SpecTable& spec = *spec_table;
+                    for ( std::size_t k = 0; k < npoint; ++k )
+                    {
+                        out[k] = spec.magnitude[k]
+                                 * std::polar( 1.0, spec.phase[k] + dpi * gd * spec.freq[k] );
+                    }
+                    continue;
+                }
+                switch ( bands[i].type() )
+                {
+                    case BandType::Pass:
+                        {
+                            const double step_size =
+                                bands[i].width() / static_cast< double >( npoint );
+                            gen_rotation(
+                                dpi * gd * bands[i].left(), dpi * gd * step_size,
+                                static_cast< unsigned int >( npoint ), out );
+                            break;
+                        }
+                    case BandType::Stop:
+                        std::fill( out, out + npoint, std::complex< double >( 0.0, 0.0 ) );
+                        break;
+                    case BandType::Transition:
+                    default: break;
+                }
+            }
+        }
+
+        /* # フィルタ構造体
+         *   所望群遅延を変えたフィルタ構造体を作る
+         *   周波数グリッド・目的関数の重みの表・セクション応答のキャッシュは共有し，
+         *   所望特性の表のみ作り直す(評価値のキャッシュは新しいものにする)
+         *
+         * # 引数
+         * double gd : 所望群遅延
+         * # 返り値
+         * FilterParam param : 所望群遅延をgdとしたフィルタ構造体
+         */
+        FilterParam FilterParam::retarget( double gd ) const
+        {
+            std::vector< std::size_t > split( bands.size() );
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                split[i] = desire_res[i].size();
+            }
+            auto new_desire = std::make_shared< GridTable >( split, 1 );
+            fill_desire( gd, new_desire->plane_data( 0 ) );
+
+            FilterParam param( *this );
+            param.group_delay = gd;
+            param.bind_grid( grid_table, std::move( new_desire ) );
+            if ( result_cache )
+            {
+                param.enable_result_cache( result_cache->max_entries() );
+            }
+            return param;
+        }
+
+        /* # フィルタ構造体
+         *   所望群遅延を変えたフィルタ構造体を一括で作る
+         *   全目標の所望特性を1つの表(目標ごとに1面)に1回の確保で書き込み，
+         *   各構造体はその表の自身の面を参照する
+         *
+         * # 引数
+         * vector<double>& gds : 所望群遅延の配列
+         * # 返り値
+         * vector<FilterParam> params : gdsの順のフィルタ構造体
+         */
+        std::vector< FilterParam >
+        FilterParam::retarget_batch( const std::vector< double >& gds ) const
+        {
+            std::vector< std::size_t > split( bands.size() );
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                split[i] = desire_res[i].size();
+            }
+            auto new_desire = std::make_shared< GridTable >( split, gds.size() );
+            for ( std::size_t t = 0; t < gds.size(); ++t )
+            {
+                fill_desire( gds[t], new_desire->plane_data( t ) );
+            }
+            const std::shared_ptr< const GridTable > shared_desire = std::move( new_desire );
+
+            std::vector< FilterParam > params;
+            params.reserve( gds.size() );
+            for ( std::size_t t = 0; t < gds.size(); ++t )
+            {
+                params.emplace_back( *this );
+                params.back().group_delay = gds[t];
+                params.back().bind_grid( grid_table, shared_desire, t );
+                if ( result_cache )
+                {
+                    params.back().enable_result_cache( result_cache->max_entries() );
+                }
+            }
+            return params;
+        }
+
+        /* # フィルタ構造体
+         *   振幅隆起の閾値を変えたフィルタ構造体を作る(表はすべて共有する)
+         *
+         * # 引数
+         * double threshold : 振幅隆起の閾値
+         */
+        FilterParam FilterParam::with_threshold( double threshold ) const
+        {
+            FilterParam param( *this );
+            param.set_threshold_riple( threshold );
+            return param;
+        }
+
         /* # フィルタ構造体
          *   複素正弦波の基本波(e^-jω)を生成する関数
          *   刻みは引数の周波数帯域幅と分割数に応じる
@@ -474,20 +932,8 @@ namespace filter
         std::vector< std::complex< double > >
         FilterParam::gen_csw( const BandParam& bp, const unsigned int nsplit )
         {
-            std::vector< std::complex< double > > csw;
-            csw.reserve( nsplit );
-            const double step_size =
-                bp.width() / static_cast< double >( nsplit );
-            const double left = bp.left();
-            constexpr double dpi = -2.0 * M_PI;    // double pi
-
-            for ( unsigned int i = 0; i < nsplit; ++i )
-            {
-                csw.emplace_back( std::polar(
-                    1.0,
-                    dpi * ( left + step_size * static_cast< double >( i ) ) ) );
-            }
-
+            std::vector< std::complex< double > > csw( nsplit );
+            gen_tables( bp, nsplit, 0.0, csw.data(), nullptr, nullptr );
             return csw;
         }
 
@@ -508,86 +954,67 @@ namespace filter
         std::vector< std::complex< double > >
         FilterParam::gen_csw2( const BandParam& bp, const unsigned int nsplit )
         {
-            std::vector< std::complex< double > > csw2;
-            csw2.reserve( nsplit );
-            const double step_size =
-                bp.width() / static_cast< double >( nsplit );
-            const double left = bp.left();
-            constexpr double dpi = -4.0 * M_PI;    // quadrical pi
-
-            for ( unsigned int i = 0; i < nsplit; ++i )
-            {
-                csw2.emplace_back( std::polar(
-                    1.0,
-                    dpi * ( left + step_size * static_cast< double >( i ) ) ) );
-            }
-
+            std::vector< std::complex< double > > csw2( nsplit );
+            gen_tables( bp, nsplit, 0.0, nullptr, csw2.data(), nullptr );
             return csw2;
         }
 
+        /* # フィルタ構造体
+         *   所望特性を生成する関数
+         *   通過域で e^-jωτ (τ = group_delay)，阻止域で0，遷移域で要素なし
+         */
         std::vector< std::complex< double > > FilterParam::gen_desire_res(
             const BandParam& bp,
             const unsigned int nsplit,
             const double group_delay )
         {
-            std::vector< std::complex< double > > desire;
-
-            switch ( bp.type() )
+            std::vector< std::complex< double > > desire(
+                bp.type() == BandType::Transition ? 0 : nsplit );
+            if ( !desire.empty() )
             {
-                case BandType::Pass:
-                    {
-                        desire.reserve( nsplit );
-                        const double step_size =
-                            bp.width() / static_cast< double >( nsplit );
-                        const double left = bp.left();
-                        constexpr double dpi = 2.0 * M_PI;    // double pi
-                        const double ang = -dpi * group_delay;
-
-                        for ( unsigned int i = 0; i < nsplit; ++i )
-                        {
-                            desire.emplace_back( std::polar(
-                                1.0, ang
-                                         * ( left
-                                             + step_size
-                                                   * static_cast< double >(
-                                                       i ) ) ) );
-                        }
-                        break;
-                    }
-                case BandType::Stop:
-                    {
-                        desire.resize( nsplit, 0.0 );
-                        break;
-                    }
-                case BandType::Transition: break;
-                default:
-                    {
-                        fprintf(
-                            stderr, "Error: [%s l.%d]Undefined band.\n",
-                            __FILE__, __LINE__ );
-                        exit( EXIT_FAILURE );
-                    }
+                gen_tables( bp, nsplit, group_delay, nullptr, nullptr, desire.data() );
             }
-
             return desire;
         }
 
+        /* # フィルタ構造体
+         *   セクション積による周波数特性計算関数を次数の偶奇で選択する
+         */
+        std::vector< std::vector< std::complex< double > > >
+        FilterParam::freq_res_section( const std::vector< double >& coef ) const
+        {
+            switch ( parity )
+            {
+                case OrderParity::SO: return freq_res_so( coef );
+                case OrderParity::NO: return freq_res_no( coef );
+                case OrderParity::MO: return freq_res_mo( coef );
+                case OrderParity::SE:
+                default: return freq_res_se( coef );
+            }
+        }
+
         std::vector< std::vector< std::complex< double > > >
         FilterParam::freq_res_se( const std::vector< double >& coef ) const
         {
             using std::complex;
             using std::vector;
 
+            const ArrayView< double > c = make_view( coef );
+
             vector< vector< complex< double > > > res;
             res.reserve( bands.size() );
 
             for ( unsigned int i = 0; i < bands.size();
                   ++i )    // 周波数帯域のループ
             {
+                const BandView w = csw[i];
+                const BandView w2 = csw2[i];
+                const std::size_t npoint = w.size();
+
                 vector< complex< double > > band_res;
-                band_res.reserve( csw.at( i ).size() );
+                band_res.reserve( npoint );
 
-                for ( unsigned int j = 0; j < csw.at( i ).size();
+                for ( unsigned int j = 0; j < npoint;
                       ++j )    // 周波数帯域内の分割数によるループ
                 {
                     complex< double > frac_over( 1.0, 1.0 );
@@ -595,17 +1022,17 @@ namespace filter
 
                     for ( unsigned int n = 1; n < n_order; n += 2 )
                     {
-                        frac_over *= 1.0 + coef.at( n ) * csw.at( i ).at( j )
-                                     + coef.at( n + 1 ) * csw2.at( i ).at( j );
+                        frac_over *= 1.0 + c[n] * w[j]
+                                     + c[n + 1] * w2[j];
                     }
                     for ( unsigned int m = n_order + 1; m < opt_order();
                           m += 2 )
                     {
-                        frac_under *= 1.0 + coef.at( m ) * csw.at( i ).at( j )
-                                      + coef.at( m + 1 ) * csw2.at( i ).at( j );
+                        frac_under *= 1.0 + c[m] * w[j]
+                                      + c[m + 1] * w2[j];
                     }
                     band_res.emplace_back(
-                        coef.at( 0 ) * ( frac_over / frac_under ) );
+                        c[0] * ( frac_over / frac_under ) );
                 }
                 res.emplace_back( band_res );
             }
@@ -619,39 +1046,45 @@ namespace filter
             using std::complex;
             using std::vector;
 
+            const ArrayView< double > c = make_view( coef );
+
             vector< vector< complex< double > > > res;
             res.reserve( bands.size() );
 
             for ( unsigned int i = 0; i < bands.size();
                   ++i )    // 周波数帯域のループ
             {
+                const BandView w = csw[i];
+                const BandView w2 = csw2[i];
+                const std::size_t npoint = w.size();
+
                 vector< complex< double > > band_res;
-                band_res.reserve( csw.at( i ).size() );
+                band_res.reserve( npoint );
 
-                for ( unsigned int j = 0; j < csw.at( i ).size();
+                for ( unsigned int j = 0; j < npoint;
                       ++j )    // 周波数帯域内の分割数によるループ
                 {
                     complex< double > frac_over( 1.0, 1.0 );
                     complex< double > frac_under( 1.0, 1.0 );
 
-                    frac_over *= 1.0 + coef.at( 1 ) * csw.at( i ).at( j );
+                    frac_over *= 1.0 + c[1] * w[j];
                     for ( unsigned int n = 2; n < n_order; n += 2 )
                     {
-                        frac_over *= 1.0 + coef.at( n ) * csw.at( i ).at( j )
-                                     + coef.at( n + 1 ) * csw2.at( i ).at( j );
+                        frac_over *= 1.0 + c[n] * w[j]
+                                     + c[n + 1] * w2[j];
                     }
 
                     frac_under *=
-                        1.0 + coef.at( n_order + 1 ) * csw.at( i ).at( j );
+                        1.0 + c[n_order + 1] * w[j];
                     for ( unsigned int m = n_order + 2; m < opt_order();
                           m += 2 )
                     {
-                        frac_under *= 1.0 + coef.at( m ) * csw.at( i ).at( j )
-                                      + coef.at( m + 1 ) * csw2.at( i ).at( j );
+                        frac_under *= 1.0 + c[m] * w[j]
+                                      + c[m + 1] * w2[j];
                     }
 
                     band_res.emplace_back(
-                        coef.at( 0 ) * ( frac_over / frac_under ) );
+                        c[0] * ( frac_over / frac_under ) );
                 }
                 res.emplace_back( band_res );
             }
@@ -664,39 +1097,45 @@ namespace filter
             using std::complex;
             using std::vector;
 
+            const ArrayView< double > c = make_view( coef );
+
             vector< vector< complex< double > > > freq;
             freq.reserve( bands.size() );
 
             for ( unsigned int i = 0; i < bands.size();
                   ++i )    // 周波数帯域のループ
             {
+                const BandView w = csw[i];
+                const BandView w2 = csw2[i];
+                const std::size_t npoint = w.size();
+
                 vector< complex< double > > freq_band;
-                freq_band.reserve( csw.at( i ).size() );
+                freq_band.reserve( npoint );
 
-                for ( unsigned int j = 0; j < csw.at( i ).size();
+                for ( unsigned int j = 0; j < npoint;
                       ++j )    // 周波数帯域内の分割数によるループ
                 {
                     complex< double > freq_denominator( 1.0, 1.0 );
                     complex< double > freq_numerator( 1.0, 1.0 );
 
-                    freq_numerator *= 1.0 + coef.at( 1 ) * csw.at( i ).at( j );
+                    freq_numerator *= 1.0 + c[1] * w[j];
                     for ( unsigned int n = 2; n < n_order;
                           n += 2 )    //分子の総乗ループ
                     {
                         freq_numerator *=
-                            1.0 + coef.at( n ) * csw.at( i ).at( j )
-                            + coef.at( n + 1 ) * csw2.at( i ).at( j );
+                            1.0 + c[n] * w[j]
+                            + c[n + 1] * w2[j];
                     }
                     for ( unsigned int m = n_order + 1; m < opt_order();
                           m += 2 )    //分母の総乗ループ
                     {
                         freq_denominator *=
-                            1.0 + coef.at( m ) * csw.at( i ).at( j )
-                            + coef.at( m + 1 ) * csw2.at( i ).at( j );
+                            1.0 + c[m] * w[j]
+                            + c[m + 1] * w2[j];
                     }
 
                     freq_band.emplace_back(
-                        coef.at( 0 ) * ( freq_numerator / freq_denominator ) );
+                        c[0] * ( freq_numerator / freq_denominator ) );
                 }
                 freq.emplace_back( freq_band );
             }
@@ -710,16 +1149,22 @@ namespace filter
             using std::complex;
             using std::vector;
 
+            const ArrayView< double > c = make_view( coef );
+
             vector< vector< complex< double > > > freq;
             freq.reserve( bands.size() );
 
             for ( unsigned int i = 0; i < bands.size();
                   ++i )    // 周波数帯域のループ
             {
+                const BandView w = csw[i];
+                const BandView w2 = csw2[i];
+                const std::size_t npoint = w.size();
+
                 vector< complex< double > > freq_band;
-                freq_band.reserve( csw.at( i ).size() );
+                freq_band.reserve( npoint );
 
-                for ( unsigned int j = 0; j < csw.at( i ).size();
+                for ( unsigned int j = 0; j < npoint;
                       ++j )    // 周波数帯域内の分割数によるループ
                 {
                     complex< double > nume( 1.0, 1.0 );
@@ -727,39 +1172,394 @@ namespace filter
 
                     for ( unsigned int n = 1; n < n_order; n += 2 )
                     {
-                        nume *= 1.0 + coef.at( n ) * csw.at( i ).at( j )
-                                + coef.at( n + 1 ) * csw2.at( i ).at( j );
+                        nume *= 1.0 + c[n] * w[j]
+                                + c[n + 1] * w2[j];
                     }
-                    deno *= 1.0 + coef.at( n_order + 1 ) * csw.at( i ).at( j );
+                    deno *= 1.0 + c[n_order + 1] * w[j];
                     for ( unsigned int m = n_order + 2; m < opt_order();
                           m += 2 )
                     {
-                        deno *= 1.0 + coef.at( m ) * csw.at( i ).at( j )
-                                + coef.at( m + 1 ) * csw2.at( i ).at( j );
+                        deno *= 1.0 + c[m] * w[j]
+                                + c[m + 1] * w2[j];
                     }
-                    freq_band.emplace_back( coef.at( 0 ) * ( nume / deno ) );
+                    freq_band.emplace_back( c[0] * ( nume / deno ) );
                 }
                 freq.emplace_back( freq_band );
             }
             return freq;
         }
 
-        std::vector< std::vector< double > >
-        FilterParam::group_delay_se( const std::vector< double >& coef ) const
+        /* # フィルタ構造体
+         *   セクション応答のキャッシュを用いた周波数特性計算関数
+         *   各セクションの周波数グリッド上の値をキャッシュから取得し(無ければ計算して登録)，
+         *   分子・分母ごとにそれらの積をとる
+         *   1次セクションは2次の係数を0としたセクションとして扱う
+         */
+        std::vector< std::vector< std::complex< double > > >
+        FilterParam::freq_res_cached( const std::vector< double >& coef ) const
         {
             using std::complex;
             using std::vector;
 
-            vector< vector< double > > res;
-            res.reserve( bands.size() );
+            const std::size_t npoint = grid_table->npoint();
+
+            vector< complex< double > > nume( npoint, complex< double >( 1.0, 0.0 ) );
+            vector< complex< double > > deno( npoint, complex< double >( 1.0, 0.0 ) );
+
+            auto multiply = [&]( vector< complex< double > >& acc, double c1, double c2 )
+            {
+                auto factor = section_factor( c1, c2 );
+                for ( std::size_t k = 0; k < npoint; ++k )
+                {
+                    acc[k] *= ( *factor )[k];
+                }
+            };
+
+            const unsigned int n_odd = n_order % 2;
+            const unsigned int m_odd = m_order % 2;
+            if ( n_odd == 1 )
+            {
+                multiply( nume, coef.at( 1 ), 0.0 );
+            }
+            for ( unsigned int n = 1 + n_odd; n < n_order; n += 2 )
+            {
+                multiply( nume, coef.at( n ), coef.at( n + 1 ) );
+            }
+            if ( m_odd == 1 )
+            {
+                multiply( deno, coef.at( n_order + 1 ), 0.0 );
+            }
+            for ( unsigned int m = n_order + 1 + m_odd; m < opt_order(); m += 2 )
+            {
+                multiply( deno, coef.at( m ), coef.at( m + 1 ) );
+            }
+
+            vector< vector< complex< double > > > res;
+            res.reserve( bands.size() );
+            std::size_t k = 0;
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                vector< complex< double > > band_res;
+                band_res.reserve( csw[i].size() );
+                for ( std::size_t j = 0; j < csw[i].size(); ++j, ++k )
+                {
+                    band_res.emplace_back( coef.at( 0 ) * ( nume[k] / deno[k] ) );
+                }
+                res.emplace_back( std::move( band_res ) );
+            }
+            return res;
+        }
+
+        /* # フィルタ構造体
+         *   セクション(1 + c1 e^-jω + c2 e^-j2ω)の周波数グリッド全体での値を返す
+         *   キャッシュに無い場合は計算して登録する
+         */
+        std::shared_ptr< const SectionCache::Factor >
+        FilterParam::section_factor( double c1, double c2 ) const
+        {
+            auto factor = section_cache->find( c1, c2 );
+            if ( factor )
+            {
+                return factor;
+            }
+
+            SectionCache::Factor value;
+            const std::size_t npoint = grid_table->npoint();
+            value.reserve( npoint );
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                const std::complex< double >* w = csw[i].data();
+                const std::complex< double >* w2 = csw2[i].data();
+                for ( std::size_t j = 0; j < csw[i].size(); ++j )
+                {
+                    value.emplace_back( 1.0 + c1 * w[j] + c2 * w2[j] );
+                }
+            }
+            return section_cache->insert( c1, c2, std::move( value ) );
+        }
+
+        /* # フィルタ構造体
+         *   周波数特性計算関数の並列版
+         *   全帯域を連結した周波数点を連続した区間に分割し，
+         *   各スレッドは自分の区間の結果のみを書き込む
+         */
+        std::vector< std::vector< std::complex< double > > >
+        FilterParam::freq_res_parallel( const std::vector< double >& coef ) const
+        {
+            using std::complex;
+            using std::vector;
+
+            vector< vector< complex< double > > > res( bands.size() );
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                res[i].resize( csw[i].size() );
+            }
+
+            const auto offsets = band_offsets();
+            const double* c = coef.data();
+            parallel_for(
+                offsets.back(), sweep_threads, 4096,
+                [&]( std::size_t k0, std::size_t k1, std::size_t )
+                {
+                    for ( unsigned int i = 0; i < bands.size(); ++i )
+                    {
+                        const std::size_t j0 = std::max( k0, offsets[i] ) - offsets[i];
+                        const std::size_t j1 = std::min( k1, offsets[i + 1] );
+                        for ( std::size_t j = j0; j + offsets[i] < j1; ++j )
+                        {
+                            res[i][j] = cascade_response(
+                                c, n_order, m_order, csw[i][j], csw2[i][j] );
+                        }
+                    }
+                } );
+
+            return res;
+        }
+
+        /* # フィルタ構造体
+         *   周波数特性計算関数の多項式版
+         *   候補ごとに分子・分母を直接型の多項式へ展開し，
+         *   各周波数点ではcosω, sinωのみを用いるClenshawの漸化式で評価する
+         *   1次あたりの演算が実数の乗算1回・加算2回で済むため，高次で速い
+         */
+        std::vector< std::vector< std::complex< double > > >
+        FilterParam::freq_res_horner( const std::vector< double >& coef ) const
+        {
+            using std::complex;
+            using std::vector;
+
+            const vector< double > nume = expand_sections( coef.data() + 1, n_order );
+            const vector< double > deno =
+                expand_sections( coef.data() + 1 + n_order, m_order );
+            const double gain = coef.at( 0 );
+
+            vector< vector< complex< double > > > res( bands.size() );
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                res[i].resize( csw[i].size() );
+                for ( std::size_t j = 0; j < csw[i].size(); ++j )
+                {
+                    // csw = e^-jω = cosω - j sinω
+                    const double c = csw[i][j].real();
+                    const double s = -csw[i][j].imag();
+                    res[i][j] = gain
+                                * ( clenshaw_response( nume.data(), n_order, c, s )
+                                    / clenshaw_response( deno.data(), m_order, c, s ) );
+                }
+            }
+            return res;
+        }
+
+        /* # フィルタ構造体
+         *   周波数特性の計算方式を変更する
+         *   Autoを与えた場合は，次数の組と精度からSectionProductかHornerを選択する
+         *   (select_response_engineを参照)
+         *   FFTを与えた場合は，全帯域の周波数点がビン間隔 1/N に乗る最小のNを探し，
+         *   見つからない場合はSectionProductとする(response_engineで確認できる)
+         *   HornerとFFTはセクションキャッシュ・並列計算の設定より優先する
+         *   デフォルトはSectionProduct
+         *
+         *   # 引数
+         *   ResponseEngine input : 計算方式
+         */
+        void FilterParam::set_response_engine( ResponseEngine input )
+        {
+            constexpr std::size_t max_fft_size = std::size_t( 1 ) << 26;
+
+            fft_plan.reset();
+            switch ( input )
+            {
+                case ResponseEngine::Auto:
+                    engine = select_response_engine();
+                    break;
+                case ResponseEngine::FFT:
+                    {
+                        engine = ResponseEngine::SectionProduct;
+                        std::size_t npoint = 2;
+                        while ( npoint < std::max( n_order, m_order ) + 1 )
+                        {
+                            npoint <<= 1;
+                        }
+                        for ( ; npoint <= max_fft_size; npoint <<= 1 )
+                        {
+                            bool aligned = true;
+                            for ( unsigned int i = 0; i < bands.size() && aligned; ++i )
+                            {
+                                std::size_t first = 0;
+                                std::size_t stride = 0;
+                                aligned = fft_bins( npoint, i, first, stride );
+                            }
+                            if ( aligned )
+                            {
+                                fft_plan = std::make_shared< const RealFFT >( npoint );
+                                engine = ResponseEngine::FFT;
+                                break;
+                            }
+                        }
+                        break;
+                    }
+                case ResponseEngine::SectionProduct:
+                case ResponseEngine::Horner:
+                default:
+                    engine = input;
+                    break;
+            }
+        }
+
+        /* # フィルタ構造体
+         *   帯域iの周波数点 left + step*j をN点FFTのビン番号 first + stride*j に対応付ける
+         *
+         *   先頭のずれと刻みのずれを帯域の点数分積み上げた最後の点のずれ
+         *     |left*N - first| + (点数 - 1) × |step*N - stride|
+         *   がビン間隔のmax_drift倍以下の場合のみ一致とみなす(Nによらない固定の割合)
+         *
+         * # 返り値
+         * bool aligned : 全点がビンに一致し，かつ0.5以下に収まる場合true
+         */
+        bool FilterParam::fft_bins(
+            std::size_t npoint, std::size_t i, std::size_t& first, std::size_t& stride ) const
+        {
+            constexpr double max_drift = 1.0e-6;    // 許容する点のずれ [ビン]
+            if ( spec_table )
+            {
+                return false;    // 表形式の所望特性は等間隔とは限らない
+            }
+            const double n = static_cast< double >( npoint );
+            const double nsplit = static_cast< double >( csw.at( i ).size() );
+            const double left = bands.at( i ).left() * n;
+            const double step = bands.at( i ).width() / nsplit * n;
+            const double rleft = std::round( left );
+            const double rstep = std::round( step );
+            const double drift = std::abs( left - rleft )
+                                 + ( nsplit > 1.0 ? nsplit - 1.0 : 0.0 ) * std::abs( step - rstep );
+            if ( !( drift <= max_drift ) || ( rstep < 1.0 && csw.at( i ).size() > 1 ) )
+            {
+                return false;
+            }
+            first = static_cast< std::size_t >( rleft );
+            stride = static_cast< std::size_t >( rstep );
+            return csw.at( i ).empty()
+                   || first + stride * ( csw.at( i ).size() - 1 ) <= npoint / 2;
+        }
+
+        /* # フィルタ構造体
+         *   周波数特性計算関数のFFT版
+         *   展開した分子・分母の多項式をN点にゼロ詰めして実数FFTを行い，
+         *   各帯域の周波数点に対応するビンの比を取る
+         *   計算量は候補あたりO(N log N)で，非常に密な検証・描画用のグリッドに向く
+         */
+        std::vector< std::vector< std::complex< double > > >
+        FilterParam::freq_res_fft( const std::vector< double >& coef ) const
+        {
+            using std::complex;
+            using std::vector;
+
+            const std::size_t npoint = fft_plan->size();
+            const vector< double > nume = expand_sections( coef.data() + 1, n_order );
+            const vector< double > deno =
+                expand_sections( coef.data() + 1 + n_order, m_order );
+            vector< complex< double > > nume_spec( npoint / 2 + 1 );
+            vector< complex< double > > deno_spec( npoint / 2 + 1 );
+            fft_plan->forward( nume.data(), nume.size(), nume_spec.data() );
+            fft_plan->forward( deno.data(), deno.size(), deno_spec.data() );
+            const double gain = coef.at( 0 );
+
+            vector< vector< complex< double > > > res( bands.size() );
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                std::size_t first = 0;
+                std::size_t stride = 0;
+                fft_bins( npoint, i, first, stride );
+                res[i].resize( csw[i].size() );
+                for ( std::size_t j = 0; j < csw[i].size(); ++j )
+                {
+                    const std::size_t bin = first + stride * j;
+                    res[i][j] = gain * ( nume_spec[bin] / deno_spec[bin] );
+                }
+            }
+            return res;
+        }
+
+        /* # フィルタ構造体
+         *   周波数特性の計算方式を次数の組ごとに選択する
+         *   単位円上の零点と半径0.9の極を持つ係数列でセクション積との相対誤差を求め，
+         *   許容値以下で，かつ分子・分母の次数がhorner_max_order以下の場合はHornerとする
+         *   (Hornerは次数に対して演算量の増え方が大きく，次数9前後でセクション積と
+         *    速度が逆転する．閾値はtools/bench_response_engine.cppの計測による)
+         *   計測時間によらないため，同じ次数の組では常に同じ方式を選ぶ
+         */
+        ResponseEngine FilterParam::select_response_engine() const
+        {
+            constexpr double tolerance = 1.0e-9;    // 許容する相対誤差
+            constexpr unsigned int horner_max_order = 8;
+
+            if ( std::max( n_order, m_order ) > horner_max_order )
+            {
+                return ResponseEngine::SectionProduct;
+            }
+
+            // 精度の確認用の係数列
+            std::vector< double > probe( opt_order(), 0.0 );
+            probe[0] = 1.0;
+            const auto fill = [&probe]( unsigned int first, unsigned int order, double radius )
+            {
+                const unsigned int odd = order % 2;
+                const unsigned int nsec = order / 2;
+                if ( odd == 1 )
+                {
+                    probe[first] = -radius;
+                }
+                for ( unsigned int k = 0; k < nsec; ++k )
+                {
+                    const double theta =
+                        M_PI * ( static_cast< double >( k ) + 0.5 ) / static_cast< double >( nsec );
+                    probe[first + odd + 2 * k] = -2.0 * radius * std::cos( theta );
+                    probe[first + odd + 2 * k + 1] = radius * radius;
+                }
+            };
+            fill( 1, n_order, 1.0 );
+            fill( 1 + n_order, m_order, 0.9 );
+
+            const auto ref = freq_res_section( probe );
+            const auto res = freq_res_horner( probe );
+            double error = 0.0;
+            double scale = 0.0;
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                for ( std::size_t j = 0; j < ref[i].size(); ++j )
+                {
+                    error = std::max( error, std::abs( res[i][j] - ref[i][j] ) );
+                    scale = std::max( scale, std::abs( ref[i][j] ) );
+                }
+            }
+
+            return std::isfinite( error ) && error <= tolerance * scale
+                       ? ResponseEngine::Horner
+                       : ResponseEngine::SectionProduct;
+        }
+
+        std::vector< std::vector< double > >
+        FilterParam::group_delay_se( const std::vector< double >& coef ) const
+        {
+            using std::complex;
+            using std::vector;
+
+            const ArrayView< double > c = make_view( coef );
+
+            vector< vector< double > > res;
+            res.reserve( bands.size() );
 
             for ( unsigned int i = 0; i < bands.size();
                   ++i )    // 周波数帯域のループ
             {
+                const BandView w = csw[i];
+                const BandView w2 = csw2[i];
+                const std::size_t npoint = w.size();
+
                 vector< double > band_res;
-                band_res.reserve( csw.at( i ).size() );
+                band_res.reserve( npoint );
 
-                for ( unsigned int j = 0; j < csw.at( i ).size();
+                for ( unsigned int j = 0; j < npoint;
                       ++j )    // 周波数帯域内の分割数によるループ
                 {
                     complex< double > second_over( 0.0, 0.0 );
@@ -768,291 +1568,1727 @@ namespace filter
                     for ( unsigned int n = 1; n < n_order; n += 2 )
                     {
                         second_over +=
-                            ( coef.at( n ) * csw.at( i ).at( j )
-                              + 2.0 * coef.at( n + 1 ) * csw2.at( i ).at( j ) )
-                            / ( 1.0 + coef.at( n ) * csw.at( i ).at( j )
-                                + coef.at( n + 1 ) * csw2.at( i ).at( j ) );
+                            ( c[n] * w[j]
+                              + 2.0 * c[n + 1] * w2[j] )
+                            / ( 1.0 + c[n] * w[j]
+                                + c[n + 1] * w2[j] );
+                    }
+                    for ( unsigned int m = n_order + 1; m < opt_order();
+                          m += 2 )
+                    {
+                        second_under +=
+                            ( c[m] * w[j]
+                              + 2.0 * c[m + 1] * w2[j] )
+                            / ( 1.0 + c[m] * w[j]
+                                + c[m + 1] * w2[j] );
+                    }
+                    complex< double > second_gd = second_over - second_under;
+
+                    band_res.emplace_back( second_gd.real() );
+                }
+                res.emplace_back( band_res );
+            }
+            return res;
+        }
+
+        std::vector< std::vector< double > >
+        FilterParam::group_delay_so( const std::vector< double >& coef ) const
+        {
+            using std::complex;
+            using std::vector;
+
+            const ArrayView< double > c = make_view( coef );
+
+            vector< vector< double > > res;
+            res.reserve( bands.size() );
+
+            for ( unsigned int i = 0; i < bands.size();
+                  ++i )    // 周波数帯域のループ
+            {
+                const BandView w = csw[i];
+                const BandView w2 = csw2[i];
+                const std::size_t npoint = w.size();
+
+                vector< double > band_res;
+                band_res.reserve( npoint );
+
+                for ( unsigned int j = 0; j < npoint;
+                      ++j )    // 周波数帯域内の分割数によるループ
+                {
+                    complex< double > prime_over =
+                        ( 1.0 + c[1] * w[j] )
+                        / ( c[1] * w[j] );
+                    complex< double > prime_under =
+                        ( 1.0 + c[n_order + 1] * w[j] )
+                        / ( c[n_order + 1] * w[j] );
+                    complex< double > prime_gd = prime_over - prime_under;
+
+                    complex< double > second_over( 0.0, 0.0 );
+                    complex< double > second_under( 0.0, 0.0 );
+
+                    for ( unsigned int n = 2; n < n_order; n += 2 )
+                    {
+                        second_over +=
+                            ( c[n] * w[j]
+                              + 2.0 * c[n + 1] * w2[j] )
+                            / ( 1.0 + c[n] * w[j]
+                                + c[n + 1] * w2[j] );
+                    }
+                    for ( unsigned int m = n_order + 2; m < opt_order();
+                          m += 2 )
+                    {
+                        second_under +=
+                            ( c[m] * w[j]
+                              + 2.0 * c[m + 1] * w2[j] )
+                            / ( 1.0 + c[m] * w[j]
+                                + c[m + 1] * w2[j] );
+                    }
+                    complex< double > second_gd = second_over - second_under;
+
+                    band_res.emplace_back( ( prime_gd + second_gd ).real() );
+                }
+                res.emplace_back( band_res );
+            }
+            return res;
+        }
+
+        std::vector< std::vector< double > >
+        FilterParam::group_delay_no( const std::vector< double >& coef ) const
+        {
+            using std::complex;
+            using std::vector;
+
+            const ArrayView< double > c = make_view( coef );
+
+            vector< vector< double > > res;
+            res.reserve( bands.size() );
+
+            for ( unsigned int i = 0; i < bands.size();
+                  ++i )    // 周波数帯域のループ
+            {
+                const BandView w = csw[i];
+                const BandView w2 = csw2[i];
+                const std::size_t npoint = w.size();
+
+                vector< double > band_res;
+                band_res.reserve( npoint );
+
+                for ( unsigned int j = 0; j < npoint;
+                      ++j )    // 周波数帯域内の分割数によるループ
+                {
+                    complex< double > prime_gd =
+                        ( 1.0 + c[1] * w[j] )
+                        / ( c[1]
+                            * w[j] );    // calculate fractional over
+
+                    complex< double > second_over( 0.0, 0.0 );
+                    complex< double > second_under( 0.0, 0.0 );
+
+                    for ( unsigned int n = 2; n < n_order; n += 2 )
+                    {
+                        second_over +=
+                            ( c[n] * w[j]
+                              + 2.0 * c[n + 1] * w2[j] )
+                            / ( 1.0 + c[n] * w[j]
+                                + c[n + 1] * w2[j] );
                     }
                     for ( unsigned int m = n_order + 1; m < opt_order();
                           m += 2 )
                     {
                         second_under +=
-                            ( coef.at( m ) * csw.at( i ).at( j )
-                              + 2.0 * coef.at( m + 1 ) * csw2.at( i ).at( j ) )
-                            / ( 1.0 + coef.at( m ) * csw.at( i ).at( j )
-                                + coef.at( m + 1 ) * csw2.at( i ).at( j ) );
+                            ( c[m] * w[j]
+                              + 2.0 * c[m + 1] * w2[j] )
+                            / ( 1.0 + c[m] * w[j]
+                                + c[m + 1] * w2[j] );
+                    }
+                    complex< double > second_gd = second_over - second_under;
+
+                    band_res.emplace_back( ( prime_gd + second_gd ).real() );
+                }
+                res.emplace_back( band_res );
+            }
+            return res;
+        }
+
+        std::vector< std::vector< double > >
+        FilterParam::group_delay_mo( const std::vector< double >& coef ) const
+        {
+            using std::complex;
+            using std::vector;
+
+            const ArrayView< double > c = make_view( coef );
+
+            vector< vector< double > > res;
+            res.reserve( bands.size() );
+
+            for ( unsigned int i = 0; i < bands.size();
+                  ++i )    // 周波数帯域のループ
+            {
+                const BandView w = csw[i];
+                const BandView w2 = csw2[i];
+                const std::size_t npoint = w.size();
+
+                vector< double > band_res;
+                band_res.reserve( npoint );
+
+                for ( unsigned int j = 0; j < npoint;
+                      ++j )    // 周波数帯域内の分割数によるループ
+                {
+                    complex< double > prime_gd =
+                        -( 1.0 + c[n_order + 1] * w[j] )
+                        / ( c[n_order + 1]
+                            * w[j] );    // calculate fractional under
+
+                    complex< double > second_over( 0.0, 0.0 );
+                    complex< double > second_under( 0.0, 0.0 );
+
+                    for ( unsigned int n = 1; n < n_order; n += 2 )
+                    {
+                        second_over +=
+                            ( c[n] * w[j]
+                              + 2.0 * c[n + 1] * w2[j] )
+                            / ( 1.0 + c[n] * w[j]
+                                + c[n + 1] * w2[j] );
+                    }
+                    for ( unsigned int m = n_order + 2; m < opt_order();
+                          m += 2 )
+                    {
+                        second_under +=
+                            ( c[m] * w[j]
+                              + 2.0 * c[m + 1] * w2[j] )
+                            / ( 1.0 + c[m] * w[j]
+                                + c[m + 1] * w2[j] );
+                    }
+                    complex< double > second_gd = second_over - second_under;
+
+                    band_res.emplace_back( ( prime_gd + second_gd ).real() );
+                }
+                res.emplace_back( band_res );
+            }
+            return res;
+        }
+
+        /* # フィルタ構造体
+         *   係数列の長さがopt_order()と一致することを確認する
+         *   各計算関数の入口で1回だけ呼び出し，内部のループでは添字を検査しない
+         *   (FILTER_PARAM_CHECKEDを定義した場合はループ内でも検査する)
+         */
+        void FilterParam::check_coef_size( const std::vector< double >& coef ) const
+        {
+            if ( coef.size() != opt_order() )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Size of coefficients is illegal.(size : %llu, "
+                    "expected : %u)\n",
+                    __FILE__, __LINE__, static_cast< unsigned long long >( coef.size() ),
+                    opt_order() );
+                exit( EXIT_FAILURE );
+            }
+        }
+
+        double FilterParam::judge_stability_even(
+            const std::vector< double >& coef ) const
+        {
+            const ArrayView< double > c = make_view( coef );
+            double penalty = 0.0;
+
+            for ( unsigned int n = n_order + 1; n < this->opt_order(); n += 2 )
+            {
+                if ( std::abs( c[n + 1] ) >= 1.0
+                     || c[n + 1] <= std::abs( c[n] ) - 1.0 )
+                {
+                    penalty += c[n] * c[n]
+                               + c[n + 1] * c[n + 1];
+                }
+            }
+            return penalty;
+        }
+
+        double FilterParam::judge_stability_odd(
+            const std::vector< double >& coef ) const
+        {
+            const ArrayView< double > c = make_view( coef );
+            double penalty = 0.0;
+
+            if ( std::abs( c[n_order + 1] ) >= 1.0 )
+            {
+                penalty += c[n_order + 1] * c[n_order + 1];
+            }
+            for ( unsigned int m = n_order + 2; m < opt_order(); m += 2 )
+            {
+                if ( std::abs( c[m + 1] ) >= 1.0
+                     || c[m + 1] <= std::abs( c[m] ) - 1.0 )
+                {
+                    penalty += c[m] * c[m]
+                               + c[m + 1] * c[m + 1];
+                }
+            }
+
+            return penalty;
+        }
+
+        namespace
+        {
+            /* 近似誤差の累積(ノルムごとに特殊化する)
+             *   add : 1点の誤差の2乗error2に重みweightを掛けて累積値accに加える
+             *   merge : 区間ごとの累積値をまとめる
+             *   finish : 累積値から近似誤差を求める
+             */
+            template< ErrorNorm Norm >
+            struct ErrorNormOp;
+
+            template<>
+            struct ErrorNormOp< ErrorNorm::Max >
+            {
+                static double add( double acc, double weight, double error2, double )
+                {
+                    const double current = weight * error2;
+                    return acc < current ? current : acc;
+                }
+                static double merge( double acc, double other )
+                {
+                    return std::max( acc, other );
+                }
+                static double finish( double acc, double ) { return std::sqrt( acc ); }
+            };
+
+            template<>
+            struct ErrorNormOp< ErrorNorm::L2 >
+            {
+                static double add( double acc, double weight, double error2, double )
+                {
+                    return acc + weight * error2;
+                }
+                static double merge( double acc, double other ) { return acc + other; }
+                static double finish( double acc, double ) { return std::sqrt( acc ); }
+            };
+
+            template<>
+            struct ErrorNormOp< ErrorNorm::Lp >
+            {
+                static double add( double acc, double weight, double error2, double half_p )
+                {
+                    return acc + weight * std::pow( error2, half_p );
+                }
+                static double merge( double acc, double other ) { return acc + other; }
+                static double finish( double acc, double p )
+                {
+                    return std::pow( acc, 1.0 / p );
+                }
+            };
+        }    // namespace
+
+        /* # フィルタ構造体
+         *   目的関数の設定から重みの表を作る
+         *   重み関数は近似帯域の各周波数点で1回ずつ呼び出す
+         *
+         * # 引数
+         * ObjectiveConfig& config : 目的関数の設定
+         * # 返り値
+         * shared_ptr<const ObjectiveTable> table : 重みの表
+         */
+        std::shared_ptr< const ObjectiveTable >
+        FilterParam::gen_objective_table( const ObjectiveConfig& config ) const
+        {
+            if ( !config.band_weight.empty() && config.band_weight.size() != bands.size() )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Number of band weights is illegal.(weights : %llu, "
+                    "bands : %llu)\n",
+                    __FILE__, __LINE__,
+                    static_cast< unsigned long long >( config.band_weight.size() ),
+                    static_cast< unsigned long long >( bands.size() ) );
+                exit( EXIT_FAILURE );
+            }
+            if ( config.norm == ErrorNorm::Lp && !( config.p >= 1.0 && std::isfinite( config.p ) ) )
+            {
+                fprintf(
+                    stderr, "Error: [%s l.%d]Order of Lp norm is illegal.(p : %f)\n",
+                    __FILE__, __LINE__, config.p );
+                exit( EXIT_FAILURE );
+            }
+
+            auto table = std::make_shared< ObjectiveTable >();
+            table->norm = config.norm;
+            table->check_stability = true;
+            table->stability_weight = config.stability_weight;
+            table->riple_weight = config.riple_weight;
+            table->p = config.norm == ErrorNorm::L2 ? 2.0 : config.p;
+            table->half_p = 0.5 * table->p;
+            table->weight.assign( grid_table->npoint(), 1.0 );
+
+            std::size_t napprox = 0;    // 近似帯域の全点数
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                if ( bands[i].type() != BandType::Transition )
+                {
+                    napprox += csw[i].size();
+                }
+            }
+            const double inv_napprox =
+                napprox == 0 ? 1.0 : 1.0 / static_cast< double >( napprox );
+
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                if ( bands[i].type() == BandType::Transition )
+                {
+                    continue;
+                }
+                const bool weighted = !config.band_weight.empty() && config.band_weight[i];
+                const std::size_t npoint = csw[i].size();
+                const std::size_t offset = band_offsets()[i];
+                const double step = bands[i].width() / static_cast< double >( npoint );
+                double* weight = table->weight.data() + offset;
+
+                for ( std::size_t j = 0; j < npoint; ++j )
+                {
+                    // 表形式の所望特性では，ファイルの周波数と重みを用いる
+                    const double f = spec_table
+                                         ? spec_table->freq[offset + j]
+                                         : bands[i].left() + step * static_cast< double >( j );
+                    double w = weighted ? config.band_weight[i]( f ) : 1.0;
+                    if ( spec_table )
+                    {
+                        w *= spec_table->weight[offset + j];
+                    }
+                    switch ( config.norm )
+                    {
+                        case ErrorNorm::L2: weight[j] = w * w * inv_napprox; break;
+                        case ErrorNorm::Lp:
+                            weight[j] = std::pow( std::abs( w ), table->p ) * inv_napprox;
+                            break;
+                        case ErrorNorm::Max:
+                        default: weight[j] = w * w; break;
+                    }
+                }
+            }
+            return table;
+        }
+
+        /* # フィルタ構造体
+         *   目的関数の設定を変更する
+         *   重みの表を作り直すため，評価のたびに変える場合はevaluateの
+         *   設定付きの版より，こちらで1回設定する方が速い
+         *   評価値のキャッシュは設定に依存するため，新しいものに置き換える
+         *
+         * # 引数
+         * ObjectiveConfig& input : 目的関数の設定
+         */
+        void FilterParam::set_objective( const ObjectiveConfig& input )
+        {
+            objective_table = gen_objective_table( input );
+            auto stable_table = std::make_shared< ObjectiveTable >( *objective_table );
+            stable_table->check_stability = false;
+            stable_objective_table = stable_table;
+            objective_config = input;
+            if ( result_cache )
+            {
+                enable_result_cache( result_cache->max_entries() );
+            }
+        }
+
+        /* # フィルタ構造体
+         *   ペナルティ関数法による目的関数値を計算する
+         *   評価値のキャッシュが有効な場合は，まずキャッシュを探す
+         *
+         */
+        double FilterParam::evaluate( const std::vector< double >& coef ) const
+        {
+            check_coef_size( coef );
+            if ( !result_cache )
+            {
+                return evaluate_full( coef, *objective_table );
+            }
+
+            double value = 0.0;
+            if ( !result_cache->find( coef, value ) )
+            {
+                value = evaluate_full( coef, *objective_table );
+                result_cache->insert( coef, value );
+            }
+            return value;
+        }
+
+        /* # フィルタ構造体
+         *   構築時と異なる目的関数の設定で目的関数値を計算する
+         *   重みの表をその場で作るため，同じ設定で繰り返し評価する場合は
+         *   set_objectiveを用いる(評価値のキャッシュは用いない)
+         *
+         * # 引数
+         * vector<double>& coef : 係数列
+         * ObjectiveConfig& config : 目的関数の設定
+         */
+        double FilterParam::evaluate(
+            const std::vector< double >& coef, const ObjectiveConfig& config ) const
+        {
+            check_coef_size( coef );
+            return evaluate_full( coef, *gen_objective_table( config ) );
+        }
+
+        /* # フィルタ構造体
+         *   ペナルティ関数法による目的関数値を，キャッシュを用いずに計算する
+         *
+         *   誤差・隆起は振幅の2乗(std::norm)で比較・累積し，
+         *   平方根(Lpではp乗根)は近似誤差に対して最後に1回だけ取る
+         *   (隆起のペナルティは2乗のまま用いるため平方根は不要)
+         *   精度 : |x|をsqrt(norm(x))で求める(u = 2^-53 : 単位丸め誤差)
+         *          2乗と和の丸めで(1 ± u)^2倍，平方根で(1 ± u)倍，その丸めで(1 ± u)倍のため，
+         *          真の|x|との相対誤差は2u以下で，std::abs(hypot，誤差1ulp = 2u以下)との
+         *          差は相対4u以下となる．最大値・和は単調なため，最大誤差も同じ上限に収まる
+         *          (同じ周波数特性に対する上限．freq_resとの比較では計算順序の違いによる
+         *           |H|の丸め誤差が加わり，これは誤差ではなく|H|に比例する)
+         *          ただし|x| > 1e154 では2乗がオーバーフローしてinfとなり，
+         *          |x| < 1e-154 では2乗がアンダーフローする
+         *          (いずれも目的関数値としての大小関係は変わらない)
+         */
+        double FilterParam::evaluate_full(
+            const std::vector< double >& coef, const ObjectiveTable& table ) const
+        {
+            // HornerとFFTはfreq_resで計算方式を優先して選ぶ
+            if ( engine == ResponseEngine::SectionProduct
+                 && ( sweep_threads != 1 || !section_cache ) )
+            {
+                return ( this->*select_kernel( table.norm, sweep_threads != 1 ) )( coef, table );
+            }
+
+            const std::vector< std::vector< std::complex< double > > > freq = freq_res( coef );
+            double value = 0.0;
+            switch ( table.norm )
+            {
+                case ErrorNorm::L2: value = evaluate_response< ErrorNorm::L2 >( freq, table ); break;
+                case ErrorNorm::Lp: value = evaluate_response< ErrorNorm::Lp >( freq, table ); break;
+                case ErrorNorm::Max:
+                default: value = evaluate_response< ErrorNorm::Max >( freq, table ); break;
+            }
+            return value + stability_penalty( coef, table );
+        }
+
+        /* # フィルタ構造体
+         *   安定性のペナルティ(構成上安定な媒介変数表示の評価では判別を省く)
+         */
+        double FilterParam::stability_penalty(
+            const std::vector< double >& coef, const ObjectiveTable& table ) const
+        {
+            return table.check_stability ? table.stability_weight * judge_stability( coef ) : 0.0;
+        }
+
+        /* # フィルタ構造体
+         *   ノルムと次数の偶奇の組から目的関数値の計算関数を選ぶ
+         *
+         * # 引数
+         * ErrorNorm norm : 近似誤差のノルム
+         * bool parallel : 並列版を選ぶ場合true
+         */
+        FilterParam::EvalFunc FilterParam::select_kernel( ErrorNorm norm, bool parallel ) const
+        {
+            switch ( norm )
+            {
+                case ErrorNorm::L2: return select_kernel< ErrorNorm::L2 >( parallel );
+                case ErrorNorm::Lp: return select_kernel< ErrorNorm::Lp >( parallel );
+                case ErrorNorm::Max:
+                default: return select_kernel< ErrorNorm::Max >( parallel );
+            }
+        }
+
+        template< ErrorNorm Norm >
+        FilterParam::EvalFunc FilterParam::select_kernel( bool parallel ) const
+        {
+            switch ( parity )
+            {
+                case OrderParity::SO:
+                    return parallel ? &FilterParam::evaluate_parallel_kernel< true, true, Norm >
+                                    : &FilterParam::evaluate_kernel< true, true, Norm >;
+                case OrderParity::NO:
+                    return parallel ? &FilterParam::evaluate_parallel_kernel< true, false, Norm >
+                                    : &FilterParam::evaluate_kernel< true, false, Norm >;
+                case OrderParity::MO:
+                    return parallel ? &FilterParam::evaluate_parallel_kernel< false, true, Norm >
+                                    : &FilterParam::evaluate_kernel< false, true, Norm >;
+                case OrderParity::SE:
+                default:
+                    return parallel ? &FilterParam::evaluate_parallel_kernel< false, false, Norm >
+                                    : &FilterParam::evaluate_kernel< false, false, Norm >;
+            }
+        }
+
+        /* # フィルタ構造体
+         *   計算済みの周波数特性から近似誤差と隆起のペナルティを求める
+         *   (セクションキャッシュ・Horner・FFT方式の場合に用いる)
+         */
+        template< ErrorNorm Norm >
+        double FilterParam::evaluate_response(
+            const std::vector< std::vector< std::complex< double > > >& freq,
+            const ObjectiveTable& table ) const
+        {
+            using std::complex;
+
+            double error = 0.0;    //近似誤差の累積値
+            double max_riple2 = 0.0;    //振幅隆起の2乗
+            const double threshold2 = riple_threshold2();
+
+            for ( unsigned int i = 0; i < bands.size();
+                  ++i )    // 周波数帯域のループ
+            {
+                const BandView desire = desire_res[i];
+                const ArrayView< complex< double > > res = make_view( freq[i] );
+                const double* weight = table.weight.data() + band_offsets()[i];
+                const std::size_t npoint = res.size();
+
+                for ( unsigned int j = 0; j < npoint;
+                      ++j )    // 周波数帯域内の分割数によるループ
+                {
+                    switch ( bands[i].type() )
+                    {
+                        case BandType::Pass:
+                        case BandType::Stop:
+                            {
+                                error = ErrorNormOp< Norm >::add(
+                                    error, weight[j], std::norm( desire[j] - res[j] ),
+                                    table.half_p );
+                                break;
+                            }
+                        case BandType::Transition:
+                            {
+                                double current_riple2 = std::norm( res[j] );
+                                if ( current_riple2 > threshold2
+                                     && current_riple2 > max_riple2 )
+                                {
+                                    max_riple2 = current_riple2;
+                                }
+                                break;
+                            }
+                        default:
+                            {
+                                fprintf(
+                                    stderr, "Error: [%s l.%d]Undefined band.\n",
+                                    __FILE__, __LINE__ );
+                                exit( EXIT_FAILURE );
+                            }
+                    }
+                }
+            }
+            return ErrorNormOp< Norm >::finish( error, table.p )
+                   + table.riple_weight * max_riple2;
+        }
+
+        /* # フィルタ構造体
+         *   遷移域の振幅隆起の2乗の最大値を，区間の上界で点の計算を省いて求める
+         *
+         *   点の区間[j0, j1)の中央の点jcでセクションの値 P_c = 1 + a w_c + b w_c^2 を求めると，
+         *   区間内の点では |w - w_c| <= h (hは両端の点との弦の長さの大きい方)，
+         *   |w^2 - w_c^2| <= 2h より |P_c| - (|a| + 2|b|)h <= |P| <= |P_c| + (|a| + 2|b|)h となる
+         *   分子の上界の積と分母の下界の積の比が閾値以下となる区間は全点が隆起とならないため省き，
+         *   判定できない区間は2分して調べる(中央の点は実際に評価して最大値に含める)
+         *   評価する点はcascade_response_fixedと同じ順に計算し，最大値は点の順序によらないため，
+         *   結果は全点を評価した場合と一致する
+         *   丸め誤差に対しては，セクションの値に絶対誤差の余裕を，閾値に相対的な余裕を持たせる
+         *
+         * # 引数
+         * double* c : 係数列
+         * unsigned int i : 遷移域の帯域の番号
+         * double threshold2 : 隆起の閾値の2乗(0以上)
+         * # 返り値
+         * double max_riple2 : 閾値を超える|H|^2の最大値(無ければ0)
+         */
+        template< bool NOdd, bool MOdd >
+        double FilterParam::transition_riple_bounded(
+            const double* c, unsigned int i, double threshold2 ) const
+        {
+            using std::complex;
+            constexpr std::size_t leaf = 4;    // これ以下の点数の区間は直接評価する
+            constexpr double abs_margin = 1.0e-12;    // セクションの値の絶対誤差の余裕(係数の大きさとの比)
+            constexpr double rel_margin = 1.0e-6;    // 閾値に対する相対的な余裕
+
+            const complex< double >* w = csw[i].data();
+            const complex< double >* w2 = csw2[i].data();
+            const std::size_t npoint = csw[i].size();
+            const double limit2 = threshold2 * ( 1.0 - rel_margin );
+            const double* a = c + 1;
+            const double* b = c + 1 + n_order;
+
+            double max_riple2 = 0.0;
+            auto update = [&]( double current_riple2 )
+            {
+                if ( current_riple2 > threshold2 && current_riple2 > max_riple2 )
+                {
+                    max_riple2 = current_riple2;
+                }
+            };
+
+            // 分割のたびに区間の点数は半分以下になるため，未処理の区間は分割の深さ
+            // (size_tのビット数以下)+1個を超えない．呼び出しごとの確保を避けて固定長とする
+            constexpr std::size_t max_stack = std::numeric_limits< std::size_t >::digits + 1;
+            std::pair< std::size_t, std::size_t > stack[max_stack];
+            std::size_t top = 0;
+            stack[top++] = std::make_pair( std::size_t( 0 ), npoint );
+            while ( top > 0 )
+            {
+                --top;
+                const std::size_t j0 = stack[top].first;
+                const std::size_t j1 = stack[top].second;
+                if ( j1 - j0 <= leaf )
+                {
+                    for ( std::size_t j = j0; j < j1; ++j )
+                    {
+                        update( std::norm( cascade_response_fixed< NOdd, MOdd >(
+                            c, n_order, m_order, w[j], w2[j] ) ) );
+                    }
+                    continue;
+                }
+
+                const std::size_t jc = j0 + ( j1 - j0 ) / 2;
+                const double h = std::max( std::abs( w[j0] - w[jc] ), std::abs( w[j1 - 1] - w[jc] ) );
+                // 区間内でのセクションの値の変化の上界
+                auto spread = [&]( double p1, double p2 )
+                {
+                    return ( std::abs( p1 ) + 2.0 * std::abs( p2 ) ) * h
+                           + abs_margin * ( 1.0 + std::abs( p1 ) + std::abs( p2 ) );
+                };
+
+                complex< double > nume( 1.0, 0.0 );
+                complex< double > deno( 1.0, 0.0 );
+                double upper = std::abs( c[0] );    // 区間内の|a0 × 分子|の上界
+                double lower = 1.0;    // 区間内の|分母|の下界
+                if ( NOdd )
+                {
+                    const complex< double > f = 1.0 + a[0] * w[jc];
+                    nume *= f;
+                    upper *= std::abs( f ) + spread( a[0], 0.0 );
+                }
+                for ( unsigned int n = NOdd ? 1 : 0; n < n_order; n += 2 )
+                {
+                    const complex< double > f = 1.0 + a[n] * w[jc] + a[n + 1] * w2[jc];
+                    nume *= f;
+                    upper *= std::abs( f ) + spread( a[n], a[n + 1] );
+                }
+                if ( MOdd )
+                {
+                    const complex< double > f = 1.0 + b[0] * w[jc];
+                    deno *= f;
+                    lower *= std::max( std::abs( f ) - spread( b[0], 0.0 ), 0.0 );
+                }
+                for ( unsigned int m = MOdd ? 1 : 0; m < m_order; m += 2 )
+                {
+                    const complex< double > f = 1.0 + b[m] * w[jc] + b[m + 1] * w2[jc];
+                    deno *= f;
+                    lower *= std::max( std::abs( f ) - spread( b[m], b[m + 1] ), 0.0 );
+                }
+                update( std::norm( c[0] * ( nume / deno ) ) );
+
+                if ( !( upper * upper <= limit2 * ( lower * lower ) ) )
+                {
+                    stack[top++] = std::make_pair( j0, jc );
+                    stack[top++] = std::make_pair( jc + 1, j1 );
+                }
+            }
+            return max_riple2;
+        }
+
+        /* # フィルタ構造体
+         *   目的関数値の計算(セクション積，偶奇・ノルムを固定した版)
+         *   周波数特性の配列を作らず，各点の特性を計算してすぐに誤差・隆起を更新する
+         *   偶奇・ノルムの分岐はコンパイル時に決まるため，点のループにすべて展開される
+         *   重みは表の値を掛けるのみで，重みを変えても計算量は変わらない
+         */
+        template< bool NOdd, bool MOdd, ErrorNorm Norm >
+        double FilterParam::evaluate_kernel(
+            const std::vector< double >& coef, const ObjectiveTable& table ) const
+        {
+            using std::complex;
+
+            double error = 0.0;    //近似誤差の累積値
+            double max_riple2 = 0.0;    //振幅隆起の2乗
+            const double threshold2 = riple_threshold2();
+            const double* c = coef.data();
+
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                const complex< double >* w = csw[i].data();
+                const complex< double >* w2 = csw2[i].data();
+                const std::size_t npoint = csw[i].size();
+
+                if ( bands[i].type() == BandType::Transition && riple_bound && threshold2 >= 0.0 )
+                {
+                    max_riple2 = std::max(
+                        max_riple2, transition_riple_bounded< NOdd, MOdd >( c, i, threshold2 ) );
+                }
+                else if ( bands[i].type() == BandType::Transition )
+                {
+                    for ( std::size_t j = 0; j < npoint; ++j )
+                    {
+                        const double current_riple2 = std::norm(
+                            cascade_response_fixed< NOdd, MOdd >(
+                                c, n_order, m_order, w[j], w2[j] ) );
+                        if ( current_riple2 > threshold2 && current_riple2 > max_riple2 )
+                        {
+                            max_riple2 = current_riple2;
+                        }
+                    }
+                }
+                else
+                {
+                    const complex< double >* desire = desire_res[i].data();
+                    const double* weight = table.weight.data() + band_offsets()[i];
+                    for ( std::size_t j = 0; j < npoint; ++j )
+                    {
+                        const double error2 = std::norm(
+                            desire[j]
+                            - cascade_response_fixed< NOdd, MOdd >(
+                                c, n_order, m_order, w[j], w2[j] ) );
+                        error = ErrorNormOp< Norm >::add( error, weight[j], error2, table.half_p );
+                    }
+                }
+            }
+            return ErrorNormOp< Norm >::finish( error, table.p )
+                   + table.riple_weight * max_riple2
+                   + stability_penalty( coef, table );
+        }
+
+        /* # フィルタ構造体
+         *   複数の係数列の目的関数値を一括で計算する
+         *   周波数グリッドをL1キャッシュに収まるブロックに，候補をL2キャッシュに
+         *   収まるタイルに分割し，1つの周波数ブロックを読み込んだまま
+         *   タイル内の全候補の近似誤差・最大隆起を更新する
+         *   評価値のキャッシュが有効な場合は，ヒットしなかった候補のみ計算する
+         *
+         * # 引数
+         * vector<vector<double>>& coefs : 係数列の配列
+         * # 返り値
+         * vector<double> values : 候補ごとの目的関数値(evaluateと同じ値)
+         */
+        std::vector< double > FilterParam::evaluate_batch(
+            const std::vector< std::vector< double > >& coefs ) const
+        {
+            std::vector< double > values( coefs.size(), 0.0 );
+
+            std::vector< std::size_t > pending;
+            pending.reserve( coefs.size() );
+            for ( std::size_t c = 0; c < coefs.size(); ++c )
+            {
+                if ( coefs[c].size() != opt_order() )
+                {
+                    fprintf(
+                        stderr,
+                        "Error: [%s l.%d]Size of coefficients is illegal.(index "
+                        ": %llu, size : %llu, expected : %u)\n",
+                        __FILE__, __LINE__,
+                        static_cast< unsigned long long >( c ),
+                        static_cast< unsigned long long >( coefs[c].size() ),
+                        opt_order() );
+                    exit( EXIT_FAILURE );
+                }
+                if ( !result_cache || !result_cache->find( coefs[c], values[c] ) )
+                {
+                    pending.emplace_back( c );
+                }
+            }
+
+            evaluate_tiles( coefs, pending, values, *objective_table );
+
+            if ( result_cache )
+            {
+                for ( const auto c : pending )
+                {
+                    result_cache->insert( coefs[c], values[c] );
+                }
+            }
+            return values;
+        }
+
+        /* # フィルタ構造体
+         *   pendingで指定した候補の目的関数値をタイルごとに計算してvaluesに書き込む
+         */
+        void FilterParam::evaluate_tiles(
+            const std::vector< std::vector< double > >& coefs,
+            const std::vector< std::size_t >& pending,
+            std::vector< double >& values,
+            const ObjectiveTable& table ) const
+        {
+            // 偶奇・ノルムによる関数の選択はバッチ全体で1回のみ行う
+            const TileFunc tile_func = select_tile( table.norm );
+
+            const std::size_t cand_tile = std::max< std::size_t >( 1, tile_config.cand_tile );
+            std::vector< std::size_t > tile;
+            tile.reserve( cand_tile );
+            for ( std::size_t t = 0; t < pending.size(); t += cand_tile )
+            {
+                tile.assign(
+                    pending.begin() + static_cast< std::ptrdiff_t >( t ),
+                    pending.begin()
+                        + static_cast< std::ptrdiff_t >(
+                            std::min( pending.size(), t + cand_tile ) ) );
+                ( this->*tile_func )( coefs, tile, values, table );
+            }
+        }
+
+        FilterParam::TileFunc FilterParam::select_tile( ErrorNorm norm ) const
+        {
+            switch ( norm )
+            {
+                case ErrorNorm::L2: return select_tile< ErrorNorm::L2 >();
+                case ErrorNorm::Lp: return select_tile< ErrorNorm::Lp >();
+                case ErrorNorm::Max:
+                default: return select_tile< ErrorNorm::Max >();
+            }
+        }
+
+        template< ErrorNorm Norm >
+        FilterParam::TileFunc FilterParam::select_tile() const
+        {
+            switch ( parity )
+            {
+                case OrderParity::SO: return &FilterParam::evaluate_tile< true, true, Norm >;
+                case OrderParity::NO: return &FilterParam::evaluate_tile< true, false, Norm >;
+                case OrderParity::MO: return &FilterParam::evaluate_tile< false, true, Norm >;
+                case OrderParity::SE:
+                default: return &FilterParam::evaluate_tile< false, false, Norm >;
+            }
+        }
+
+        /* # フィルタ構造体
+         *   1タイル分の候補の目的関数値を計算する
+         *   周波数ブロック -> 候補 -> ブロック内の点の順にループする
+         */
+        template< bool NOdd, bool MOdd, ErrorNorm Norm >
+        void FilterParam::evaluate_tile(
+            const std::vector< std::vector< double > >& coefs,
+            const std::vector< std::size_t >& tile,
+            std::vector< double >& values,
+            const ObjectiveTable& table ) const
+        {
+            using std::complex;
+
+            std::vector< double > tile_error( tile.size(), 0.0 );
+            std::vector< double > max_riple2( tile.size(), 0.0 );
+            const double threshold2 = riple_threshold2();
+            const std::size_t block = std::max< std::size_t >( 1, tile_config.freq_block );
+
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                const complex< double >* w = csw[i].data();
+                const complex< double >* w2 = csw2[i].data();
+                const complex< double >* desire = desire_res[i].data();
+                const double* weight = table.weight.data() + band_offsets()[i];
+                const std::size_t npoint = csw[i].size();
+                const bool transition = bands[i].type() == BandType::Transition;
+
+                // 遷移域は候補ごとに区間の上界で判定する(最大値は点の順序によらない)
+                if ( transition && riple_bound && threshold2 >= 0.0 )
+                {
+                    for ( std::size_t t = 0; t < tile.size(); ++t )
+                    {
+                        max_riple2[t] = std::max(
+                            max_riple2[t],
+                            transition_riple_bounded< NOdd, MOdd >(
+                                coefs[tile[t]].data(), i, threshold2 ) );
+                    }
+                    continue;
+                }
+
+                for ( std::size_t j0 = 0; j0 < npoint; j0 += block )
+                {
+                    const std::size_t j1 = std::min( npoint, j0 + block );
+                    for ( std::size_t t = 0; t < tile.size(); ++t )
+                    {
+                        const double* coef = coefs[tile[t]].data();
+                        double error = tile_error[t];
+                        double riple2 = max_riple2[t];
+
+                        for ( std::size_t j = j0; j < j1; ++j )
+                        {
+                            const complex< double > res = cascade_response_fixed< NOdd, MOdd >(
+                                coef, n_order, m_order, w[j], w2[j] );
+                            if ( transition )
+                            {
+                                const double current_riple2 = std::norm( res );
+                                if ( current_riple2 > threshold2
+                                     && current_riple2 > riple2 )
+                                {
+                                    riple2 = current_riple2;
+                                }
+                            }
+                            else
+                            {
+                                error = ErrorNormOp< Norm >::add(
+                                    error, weight[j], std::norm( desire[j] - res ),
+                                    table.half_p );
+                            }
+                        }
+                        tile_error[t] = error;
+                        max_riple2[t] = riple2;
+                    }
+                }
+            }
+
+            for ( std::size_t t = 0; t < tile.size(); ++t )
+            {
+                values[tile[t]] = ErrorNormOp< Norm >::finish( tile_error[t], table.p )
+                                  + table.riple_weight * max_riple2[t]
+                                  + stability_penalty( coefs[tile[t]], table );
+            }
+        }
+
+        /* # フィルタ構造体
+         *   目的関数値の計算の並列版
+         *   4096点の区間ごとに近似誤差の累積値・最大隆起を求め，区間番号順に集約する
+         *   区間はスレッド数によらないため，L2・Lpノルムの和もスレッド数によらず一致する
+         */
+        template< bool NOdd, bool MOdd, ErrorNorm Norm >
+        double FilterParam::evaluate_parallel_kernel(
+            const std::vector< double >& coef, const ObjectiveTable& table ) const
+        {
+            using std::complex;
+
+            constexpr std::size_t block = 4096;    // 部分和を求める区間の点数
+
+            const auto offsets = band_offsets();
+            const std::size_t nblock = ( offsets.back() + block - 1 ) / block;
+            std::vector< double > block_error( nblock, 0.0 );
+            std::vector< double > block_riple2( nblock, 0.0 );
+            const double threshold2 = riple_threshold2();
+            const double* c = coef.data();
+
+            // 部分和はスレッド数によらない固定長の区間ごとに求め，スレッドには区間をまとめて割り当てる
+            parallel_for(
+                nblock, sweep_threads, 1,
+                [&]( std::size_t b0, std::size_t b1, std::size_t )
+                {
+                    for ( std::size_t b = b0; b < b1; ++b )
+                    {
+                        const std::size_t k0 = b * block;
+                        const std::size_t k1 = std::min( offsets.back(), k0 + block );
+                        double error = 0.0;
+                        double max_riple2 = 0.0;
+                        for ( unsigned int i = 0; i < bands.size(); ++i )
+                        {
+                            if ( k1 <= offsets[i] || k0 >= offsets[i + 1] )
+                            {
+                                continue;
+                            }
+                            const std::size_t j0 = std::max( k0, offsets[i] ) - offsets[i];
+                            const std::size_t j1 = std::min( k1, offsets[i + 1] ) - offsets[i];
+                            const bool transition = bands[i].type() == BandType::Transition;
+                            const double* weight = table.weight.data() + offsets[i];
+                            for ( std::size_t j = j0; j < j1; ++j )
+                            {
+                                const complex< double > res =
+                                    cascade_response_fixed< NOdd, MOdd >(
+                                        c, n_order, m_order, csw[i][j], csw2[i][j] );
+                                if ( transition )
+                                {
+                                    const double current_riple2 = std::norm( res );
+                                    if ( current_riple2 > threshold2
+                                         && current_riple2 > max_riple2 )
+                                    {
+                                        max_riple2 = current_riple2;
+                                    }
+                                }
+                                else
+                                {
+                                    error = ErrorNormOp< Norm >::add(
+                                        error, weight[j], std::norm( desire_res[i][j] - res ),
+                                        table.half_p );
+                                }
+                            }
+                        }
+                        block_error[b] = error;
+                        block_riple2[b] = max_riple2;
+                    }
+                } );
+
+            double error = 0.0;
+            double max_riple2 = 0.0;
+            for ( std::size_t b = 0; b < nblock; ++b )
+            {
+                error = ErrorNormOp< Norm >::merge( error, block_error[b] );
+                max_riple2 = std::max( max_riple2, block_riple2[b] );
+            }
+            return ErrorNormOp< Norm >::finish( error, table.p )
+                   + table.riple_weight * max_riple2
+                   + stability_penalty( coef, table );
+        }
+
+        namespace
+        {
+            void check_qformat( QFormat q )
+            {
+                if ( q.word_bits == 1 || q.word_bits > 54 )
+                {
+                    fprintf(
+                        stderr, "Error: [%s l.%d]Word length of Q format is illegal.(word : %u)\n",
+                        __FILE__, __LINE__, q.word_bits );
+                    exit( EXIT_FAILURE );
+                }
+            }
+        }    // namespace
+
+        /* # フィルタ構造体
+         *   実数の係数列をQ形式の整数係数列に量子化する(最も近い整数に丸める)
+         *   語長で表せない係数は表せる範囲の端に飽和させる
+         *
+         * # 引数
+         * vector<double>& coef : 係数列
+         * QFormat q : 係数の形式
+         * # 返り値
+         * vector<int64_t> qcoef : 整数係数列
+         */
+        std::vector< std::int64_t >
+        FilterParam::quantize( const std::vector< double >& coef, QFormat q )
+        {
+            check_qformat( q );
+            const double lower = static_cast< double >( q.min_code() );
+            const double upper = static_cast< double >( q.max_code() );
+            std::vector< std::int64_t > qcoef( coef.size() );
+            for ( std::size_t k = 0; k < coef.size(); ++k )
+            {
+                // 丸める前に飽和させ，llroundの範囲外の値を渡さない
+                const double scaled = std::ldexp( coef[k], static_cast< int >( q.frac_bits ) );
+                qcoef[k] = static_cast< std::int64_t >(
+                    std::llround( std::min( std::max( scaled, lower ), upper ) ) );
+            }
+            return qcoef;
+        }
+
+        /* # フィルタ構造体
+         *   Q形式の整数係数列を実数の係数列に戻す(q * 2^-frac_bits，|q| < 2^53で誤差なし)
+         *
+         * # 引数
+         * vector<int64_t>& qcoef : 整数係数列
+         * QFormat q : 係数の形式
+         * # 返り値
+         * vector<double> coef : 係数列
+         */
+        std::vector< double >
+        FilterParam::dequantize( const std::vector< std::int64_t >& qcoef, QFormat q )
+        {
+            std::vector< double > coef( qcoef.size() );
+            for ( std::size_t k = 0; k < qcoef.size(); ++k )
+            {
+                coef[k] = std::ldexp(
+                    static_cast< double >( qcoef[k] ), -static_cast< int >( q.frac_bits ) );
+            }
+            return coef;
+        }
+
+        /* # フィルタ構造体
+         *   量子化した係数列の目的関数値を計算する
+         *   整数係数を倍精度に誤差なく変換するため，量子化後の縦続型フィルタの
+         *   特性そのものを評価する
+         *
+         * # 引数
+         * vector<int64_t>& qcoef : 整数係数列
+         * QFormat q : 係数の形式
+         */
+        double FilterParam::evaluate_quantized(
+            const std::vector< std::int64_t >& qcoef, QFormat q ) const
+        {
+            return evaluate( dequantize( qcoef, q ) );
+        }
+
+        /* # フィルタ構造体
+         *   量子化した係数列の各係数を±1LSBずらした近傍の目的関数値を一括で計算する
+         *   values[2k]はk番目の係数を-1LSB，values[2k + 1]は+1LSBずらした値
+         *
+         *   1つの係数の変化は，それを含むセクションの因子のみを変えるため，
+         *   各点で他のセクションの積を前方・後方の積から1回だけ求めておき，
+         *   近傍ごとには変化したセクションの因子を掛ける(分母は割る)のみとする
+         *   近傍1つあたりの計算量はセクション数によらず点数に比例する
+         *   他のセクションの積の順序が異なるため，evaluate_quantizedとの差は丸め誤差程度
+         *   周波数点はtiling().freq_block点ずつの区間に分けて処理し，
+         *   作業領域は(2 × セクション数 + 5) × freq_block個の複素数に留める
+         *   語長で表せない近傍(qの範囲の端を越えるもの)は計算せず無限大とする
+         *
+         * # 引数
+         * vector<int64_t>& qcoef : 整数係数列
+         * QFormat q : 係数の形式
+         * # 返り値
+         * vector<double> values : 近傍の目的関数値(係数の数の2倍)
+         */
+        std::vector< double > FilterParam::evaluate_neighbors(
+            const std::vector< std::int64_t >& qcoef, QFormat q ) const
+        {
+            check_qformat( q );
+            std::vector< double > values( 2 * qcoef.size() );
+            switch ( objective_table->norm )
+            {
+                case ErrorNorm::L2:
+                    evaluate_neighbors_kernel< ErrorNorm::L2 >( qcoef, q, values, *objective_table );
+                    break;
+                case ErrorNorm::Lp:
+                    evaluate_neighbors_kernel< ErrorNorm::Lp >( qcoef, q, values, *objective_table );
+                    break;
+                case ErrorNorm::Max:
+                default:
+                    evaluate_neighbors_kernel< ErrorNorm::Max >( qcoef, q, values, *objective_table );
+                    break;
+            }
+            return values;
+        }
+
+        /* # フィルタ構造体
+         *   量子化した係数列の局所探索
+         *   実数の係数列を丸めた点から始め，±1LSBの近傍のうち最も良いものへの
+         *   移動を改善が無くなるかmax_step回まで繰り返す
+         *   語長で表せない近傍は無限大となるため移動先に選ばれず，結果は常に語長に収まる
+         *
+         * # 引数
+         * vector<double>& coef : 量子化前の係数列
+         * QFormat q : 係数の形式
+         * unsigned int max_step : 最大の移動回数
+         * # 返り値
+         * vector<int64_t> qcoef : 探索した整数係数列
+         */
+        std::vector< std::int64_t > FilterParam::search_quantized(
+            const std::vector< double >& coef, QFormat q, unsigned int max_step ) const
+        {
+            std::vector< std::int64_t > qcoef = quantize( coef, q );
+            double current = evaluate_quantized( qcoef, q );
+            for ( unsigned int step = 0; step < max_step; ++step )
+            {
+                const std::vector< double > values = evaluate_neighbors( qcoef, q );
+                const auto best = std::min_element( values.begin(), values.end() );
+                if ( !( *best < current ) )
+                {
+                    break;
+                }
+                const std::size_t index = static_cast< std::size_t >( best - values.begin() );
+                qcoef[index / 2] += index % 2 == 0 ? -1 : 1;
+                current = *best;
+            }
+            return qcoef;
+        }
+
+        /* # フィルタ構造体
+         *   各点の周波数特性を与える関数から近似誤差と隆起のペナルティを求める
+         *   (安定性のペナルティは含まない)
+         *
+         * # 引数
+         * Response response : 全帯域を通した点の番号から特性を返す関数
+         * ObjectiveTable& table : 重みの表
+         */
+        template< ErrorNorm Norm, typename Response >
+        double FilterParam::reduce_response( Response response, const ObjectiveTable& table ) const
+        {
+            double error = 0.0;    //近似誤差の累積値
+            double max_riple2 = 0.0;    //振幅隆起の2乗
+            const double threshold2 = riple_threshold2();
+
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                const std::size_t offset = band_offsets()[i];
+                const std::size_t npoint = csw[i].size();
+
+                if ( bands[i].type() == BandType::Transition )
+                {
+                    for ( std::size_t j = 0; j < npoint; ++j )
+                    {
+                        const double current_riple2 = std::norm( response( offset + j ) );
+                        if ( current_riple2 > threshold2 && current_riple2 > max_riple2 )
+                        {
+                            max_riple2 = current_riple2;
+                        }
+                    }
+                }
+                else
+                {
+                    const std::complex< double >* desire = desire_res[i].data();
+                    const double* weight = table.weight.data() + offset;
+                    for ( std::size_t j = 0; j < npoint; ++j )
+                    {
+                        const double error2 = std::norm( desire[j] - response( offset + j ) );
+                        error = ErrorNormOp< Norm >::add( error, weight[j], error2, table.half_p );
+                    }
+                }
+            }
+            return ErrorNormOp< Norm >::finish( error, table.p )
+                   + table.riple_weight * max_riple2;
+        }
+
+        /* # フィルタ構造体
+         *   他で計算した周波数特性から目的関数値を求める(MultiSpecEvaluatorで用いる)
+         *   累積の順序はevaluate_kernelと同じため，同じ特性からは同じ値となる
+         *
+         * # 引数
+         * vector<double>& coef : 係数列(安定性の判別に用いる)
+         * complex<double>* response : 周波数特性
+         * size_t* index : 全帯域を通した点の番号からresponseの番号への対応
+         */
+        double FilterParam::evaluate_indexed(
+            const std::vector< double >& coef,
+            const std::complex< double >* response,
+            const std::size_t* index ) const
+        {
+            const ObjectiveTable& table = *objective_table;
+            auto shared = [&]( std::size_t p ) { return response[index[p]]; };
+            double value = 0.0;
+            switch ( table.norm )
+            {
+                case ErrorNorm::L2: value = reduce_response< ErrorNorm::L2 >( shared, table ); break;
+                case ErrorNorm::Lp: value = reduce_response< ErrorNorm::Lp >( shared, table ); break;
+                case ErrorNorm::Max:
+                default: value = reduce_response< ErrorNorm::Max >( shared, table ); break;
+            }
+            return value + stability_penalty( coef, table );
+        }
+
+        template< ErrorNorm Norm >
+        void FilterParam::evaluate_neighbors_kernel(
+            const std::vector< std::int64_t >& qcoef,
+            QFormat q,
+            std::vector< double >& values,
+            const ObjectiveTable& table ) const
+        {
+            using std::complex;
+
+            struct Section
+            {
+                unsigned int first;    // 1次の係数の位置
+                bool second;    // 2次セクションの場合true
+                bool deno;    // 分母のセクションの場合true
+            };
+
+            const std::vector< double > coef = dequantize( qcoef, q );
+            check_coef_size( coef );
+
+            // セクションを係数列の順(分子，分母の順で奇数次なら1次セクションが先頭)に並べる
+            std::vector< Section > sections;
+            std::vector< std::size_t > owner( coef.size(), 0 );    // 係数が属するセクション
+            for ( unsigned int side = 0; side < 2; ++side )
+            {
+                const unsigned int order = side == 0 ? n_order : m_order;
+                const unsigned int first = side == 0 ? 1 : 1 + n_order;
+                for ( unsigned int k = 0; k < order; )
+                {
+                    const bool second = !( k == 0 && order % 2 == 1 );
+                    owner[first + k] = sections.size();
+                    if ( second )
+                    {
+                        owner[first + k + 1] = sections.size();
+                    }
+                    sections.push_back( Section { first + k, second, side == 1 } );
+                    k += second ? 2 : 1;
+                }
+            }
+            const std::size_t nsec = sections.size();
+            const std::size_t nneighbor = 2 * coef.size();
+
+            // 作業領域は1区間分のみ((2 * nsec + 5) * block個の複素数)とし，点数によらない
+            // 近傍ごとの累積値は区間をまたいで点の順に足すため，全点を一度に扱う場合と同じ値となる
+            const std::size_t block = std::max< std::size_t >( 1, tile_config.freq_block );
+            std::vector< complex< double > > fac( nsec * block );
+            std::vector< complex< double > > others( nsec * block );
+            std::vector< complex< double > > nume( block ), deno( block ), partial( block );
+            std::vector< complex< double > > ratio( block ), res( block );
+            std::vector< double > error( nneighbor, 0.0 );
+            std::vector< double > max_riple2( nneighbor, 0.0 );
+            const double threshold2 = riple_threshold2();
+
+            std::vector< double > trial( coef );
+            for ( unsigned int i = 0; i < bands.size(); ++i )
+            {
+                const complex< double >* desire = desire_res[i].data();
+                const double* weight = table.weight.data() + band_offsets()[i];
+                const std::size_t npoint = csw[i].size();
+                const bool transition = bands[i].type() == BandType::Transition;
+
+                for ( std::size_t j0 = 0; j0 < npoint; j0 += block )
+                {
+                    const std::size_t len = std::min( npoint, j0 + block ) - j0;
+                    const complex< double >* w = csw[i].data() + j0;
+                    const complex< double >* w2 = csw2[i].data() + j0;
+
+                    // cascade_response_fixedと同じ式でセクションの因子を求める
+                    auto factor = [&]( const double* c, const Section& s, std::size_t p )
+                    {
+                        return s.second ? 1.0 + c[s.first] * w[p] + c[s.first + 1] * w2[p]
+                                        : 1.0 + c[s.first] * w[p];
+                    };
+
+                    std::fill( nume.begin(), nume.end(), complex< double >( 1.0, 0.0 ) );
+                    std::fill( deno.begin(), deno.end(), complex< double >( 1.0, 0.0 ) );
+                    for ( std::size_t s = 0; s < nsec; ++s )
+                    {
+                        complex< double >* f = fac.data() + s * block;
+                        std::vector< complex< double > >& prod = sections[s].deno ? deno : nume;
+                        for ( std::size_t p = 0; p < len; ++p )
+                        {
+                            f[p] = factor( coef.data(), sections[s], p );
+                            prod[p] *= f[p];
+                        }
+                    }
+
+                    // 他のセクションの積(後方の積 × 前方の積)を求め，分子のセクションは分母の全積で
+                    // 割り，分母のセクションは分子の全積をそれで割っておく
+                    for ( unsigned int side = 0; side < 2; ++side )
+                    {
+                        std::fill( partial.begin(), partial.end(), complex< double >( 1.0, 0.0 ) );
+                        for ( std::size_t s = nsec; s-- > 0; )
+                        {
+                            if ( sections[s].deno != ( side == 1 ) )
+                            {
+                                continue;
+                            }
+                            complex< double >* o = others.data() + s * block;
+                            const complex< double >* f = fac.data() + s * block;
+                            for ( std::size_t p = 0; p < len; ++p )
+                            {
+                                o[p] = partial[p];
+                                partial[p] *= f[p];
+                            }
+                        }
+                        std::fill( partial.begin(), partial.end(), complex< double >( 1.0, 0.0 ) );
+                        for ( std::size_t s = 0; s < nsec; ++s )
+                        {
+                            if ( sections[s].deno != ( side == 1 ) )
+                            {
+                                continue;
+                            }
+                            complex< double >* o = others.data() + s * block;
+                            const complex< double >* f = fac.data() + s * block;
+                            for ( std::size_t p = 0; p < len; ++p )
+                            {
+                                o[p] = partial[p] * o[p];
+                                o[p] = side == 1 ? nume[p] / o[p] : o[p] / deno[p];
+                                partial[p] *= f[p];
+                            }
+                        }
+                    }
+                    for ( std::size_t p = 0; p < len; ++p )
+                    {
+                        ratio[p] = nume[p] / deno[p];
+                    }
+
+                    for ( std::size_t k = 0; k < coef.size(); ++k )
+                    {
+                        for ( unsigned int d = 0; d < 2; ++d )
+                        {
+                            const std::int64_t code =
+                                qcoef[k] - 1 + 2 * static_cast< std::int64_t >( d );
+                            if ( !q.contains( code ) )
+                            {
+                                continue;    // 語長で表せない近傍
+                            }
+                            trial[k] = std::ldexp(
+                                static_cast< double >( code ), -static_cast< int >( q.frac_bits ) );
+                            const double g = trial[0];
+                            const double* c = trial.data();
+                            if ( k == 0 )
+                            {
+                                for ( std::size_t p = 0; p < len; ++p )
+                                {
+                                    res[p] = g * ratio[p];
+                                }
+                            }
+                            else
+                            {
+                                const Section& s = sections[owner[k]];
+                                const complex< double >* other = others.data() + owner[k] * block;
+                                for ( std::size_t p = 0; p < len; ++p )
+                                {
+                                    res[p] = s.deno ? g * ( other[p] / factor( c, s, p ) )
+                                                    : g * ( other[p] * factor( c, s, p ) );
+                                }
+                            }
+
+                            // 区間内の特性を近傍ごとの累積値に点の順で足す
+                            const std::size_t n = 2 * k + d;
+                            for ( std::size_t p = 0; p < len; ++p )
+                            {
+                                if ( transition )
+                                {
+                                    const double current_riple2 = std::norm( res[p] );
+                                    if ( current_riple2 > threshold2
+                                         && current_riple2 > max_riple2[n] )
+                                    {
+                                        max_riple2[n] = current_riple2;
+                                    }
+                                }
+                                else
+                                {
+                                    const double error2 = std::norm( desire[j0 + p] - res[p] );
+                                    error[n] = ErrorNormOp< Norm >::add(
+                                        error[n], weight[j0 + p], error2, table.half_p );
+                                }
+                            }
+                            trial[k] = coef[k];
+                        }
                     }
-                    complex< double > second_gd = second_over - second_under;
-
-                    band_res.emplace_back( second_gd.real() );
                 }
-                res.emplace_back( band_res );
             }
-            return res;
-        }
-
-        std::vector< std::vector< double > >
-        FilterParam::group_delay_so( const std::vector< double >& coef ) const
-        {
-            using std::complex;
-            using std::vector;
 
-            vector< vector< double > > res;
-            res.reserve( bands.size() );
-
-            for ( unsigned int i = 0; i < bands.size();
-                  ++i )    // 周波数帯域のループ
+            for ( std::size_t k = 0; k < coef.size(); ++k )
             {
-                vector< double > band_res;
-                band_res.reserve( csw.at( i ).size() );
-
-                for ( unsigned int j = 0; j < csw.at( i ).size();
-                      ++j )    // 周波数帯域内の分割数によるループ
+                for ( unsigned int d = 0; d < 2; ++d )
                 {
-                    complex< double > prime_over =
-                        ( 1.0 + coef.at( 1 ) * csw.at( i ).at( j ) )
-                        / ( coef.at( 1 ) * csw.at( i ).at( j ) );
-                    complex< double > prime_under =
-                        ( 1.0 + coef.at( n_order + 1 ) * csw.at( i ).at( j ) )
-                        / ( coef.at( n_order + 1 ) * csw.at( i ).at( j ) );
-                    complex< double > prime_gd = prime_over - prime_under;
-
-                    complex< double > second_over( 0.0, 0.0 );
-                    complex< double > second_under( 0.0, 0.0 );
-
-                    for ( unsigned int n = 2; n < n_order; n += 2 )
-                    {
-                        second_over +=
-                            ( coef.at( n ) * csw.at( i ).at( j )
-                              + 2.0 * coef.at( n + 1 ) * csw2.at( i ).at( j ) )
-                            / ( 1.0 + coef.at( n ) * csw.at( i ).at( j )
-                                + coef.at( n + 1 ) * csw2.at( i ).at( j ) );
-                    }
-                    for ( unsigned int m = n_order + 2; m < opt_order();
-                          m += 2 )
+                    const std::int64_t code = qcoef[k] - 1 + 2 * static_cast< std::int64_t >( d );
+                    const std::size_t n = 2 * k + d;
+                    if ( !q.contains( code ) )
                     {
-                        second_under +=
-                            ( coef.at( m ) * csw.at( i ).at( j )
-                              + 2.0 * coef.at( m + 1 ) * csw2.at( i ).at( j ) )
-                            / ( 1.0 + coef.at( m ) * csw.at( i ).at( j )
-                                + coef.at( m + 1 ) * csw2.at( i ).at( j ) );
+                        values[n] = std::numeric_limits< double >::infinity();
+                        continue;
                     }
-                    complex< double > second_gd = second_over - second_under;
-
-                    band_res.emplace_back( ( prime_gd + second_gd ).real() );
+                    trial[k] = std::ldexp(
+                        static_cast< double >( code ), -static_cast< int >( q.frac_bits ) );
+                    values[n] = ErrorNormOp< Norm >::finish( error[n], table.p )
+                                + table.riple_weight * max_riple2[n]
+                                + stability_penalty( trial, table );
+                    trial[k] = coef[k];
                 }
-                res.emplace_back( band_res );
             }
-            return res;
         }
 
-        std::vector< std::vector< double > >
-        FilterParam::group_delay_no( const std::vector< double >& coef ) const
+        namespace
         {
-            using std::complex;
-            using std::vector;
-
-            vector< vector< double > > res;
-            res.reserve( bands.size() );
-
-            for ( unsigned int i = 0; i < bands.size();
-                  ++i )    // 周波数帯域のループ
+            // 媒介変数表示の極・反射係数の上限は安定となる範囲(0, 1)に限る
+            void check_pole_radius( double r_max )
             {
-                vector< double > band_res;
-                band_res.reserve( csw.at( i ).size() );
-
-                for ( unsigned int j = 0; j < csw.at( i ).size();
-                      ++j )    // 周波数帯域内の分割数によるループ
+                if ( !( r_max > 0.0 && r_max < 1.0 ) )
                 {
-                    complex< double > prime_gd =
-                        ( 1.0 + coef.at( 1 ) * csw.at( i ).at( j ) )
-                        / ( coef.at( 1 )
-                            * csw.at( i ).at(
-                                j ) );    // calculate fractional over
-
-                    complex< double > second_over( 0.0, 0.0 );
-                    complex< double > second_under( 0.0, 0.0 );
-
-                    for ( unsigned int n = 2; n < n_order; n += 2 )
-                    {
-                        second_over +=
-                            ( coef.at( n ) * csw.at( i ).at( j )
-                              + 2.0 * coef.at( n + 1 ) * csw2.at( i ).at( j ) )
-                            / ( 1.0 + coef.at( n ) * csw.at( i ).at( j )
-                                + coef.at( n + 1 ) * csw2.at( i ).at( j ) );
-                    }
-                    for ( unsigned int m = n_order + 1; m < opt_order();
-                          m += 2 )
-                    {
-                        second_under +=
-                            ( coef.at( m ) * csw.at( i ).at( j )
-                              + 2.0 * coef.at( m + 1 ) * csw2.at( i ).at( j ) )
-                            / ( 1.0 + coef.at( m ) * csw.at( i ).at( j )
-                                + coef.at( m + 1 ) * csw2.at( i ).at( j ) );
-                    }
-                    complex< double > second_gd = second_over - second_under;
-
-                    band_res.emplace_back( ( prime_gd + second_gd ).real() );
+                    fprintf(
+                        stderr, "Error: [%s l.%d]Maximum pole radius is illegal.(r_max : %f)\n",
+                        __FILE__, __LINE__, r_max );
+                    exit( EXIT_FAILURE );
                 }
-                res.emplace_back( band_res );
             }
-            return res;
-        }
-
-        std::vector< std::vector< double > >
-        FilterParam::group_delay_mo( const std::vector< double >& coef ) const
-        {
-            using std::complex;
-            using std::vector;
 
-            vector< vector< double > > res;
-            res.reserve( bands.size() );
-
-            for ( unsigned int i = 0; i < bands.size();
-                  ++i )    // 周波数帯域のループ
+            double clip_radius( double x, double r_max )
             {
-                vector< double > band_res;
-                band_res.reserve( csw.at( i ).size() );
-
-                for ( unsigned int j = 0; j < csw.at( i ).size();
-                      ++j )    // 周波数帯域内の分割数によるループ
-                {
-                    complex< double > prime_gd =
-                        -( 1.0 + coef.at( n_order + 1 ) * csw.at( i ).at( j ) )
-                        / ( coef.at( n_order + 1 )
-                            * csw.at( i ).at(
-                                j ) );    // calculate fractional under
+                return std::min( std::max( x, -r_max ), r_max );
+            }
+        }    // namespace
 
-                    complex< double > second_over( 0.0, 0.0 );
-                    complex< double > second_under( 0.0, 0.0 );
+        /* # フィルタ構造体
+         *   分母の媒介変数表示から係数列の分母の部分を求める(分子の部分はそのまま写す)
+         *   媒介変数は打ち切ってから写すため，出力は常に安定な係数列となる
+         *
+         * # 引数
+         * double* param : 媒介変数(opt_order()個)
+         * double* coef : 係数列の出力先(opt_order()個)
+         * PoleForm form : 分母の媒介変数表示
+         * double r_max : 半径・反射係数の上限
+         */
+        void FilterParam::map_pole_param(
+            const double* param, double* coef, PoleForm form, double r_max ) const
+        {
+            const unsigned int deno = 1 + n_order;
+            std::copy( param, param + deno, coef );
 
-                    for ( unsigned int n = 1; n < n_order; n += 2 )
+            const double* p = param + deno;
+            double* b = coef + deno;
+            unsigned int m = 0;
+            if ( m_order % 2 == 1 )
+            {
+                const double x = clip_radius( p[0], r_max );
+                b[0] = form == PoleForm::Polar ? -x : x;
+                m = 1;
+            }
+            switch ( form )
+            {
+                case PoleForm::Polar:
+                    for ( ; m < m_order; m += 2 )
                     {
-                        second_over +=
-                            ( coef.at( n ) * csw.at( i ).at( j )
-                              + 2.0 * coef.at( n + 1 ) * csw2.at( i ).at( j ) )
-                            / ( 1.0 + coef.at( n ) * csw.at( i ).at( j )
-                                + coef.at( n + 1 ) * csw2.at( i ).at( j ) );
+                        const double r = std::min( std::abs( p[m] ), r_max );
+                        b[m] = -2.0 * r * std::cos( p[m + 1] );
+                        b[m + 1] = r * r;
                     }
-                    for ( unsigned int m = n_order + 2; m < opt_order();
-                          m += 2 )
+                    break;
+                case PoleForm::Reflection:
+                default:
+                    for ( ; m < m_order; m += 2 )
                     {
-                        second_under +=
-                            ( coef.at( m ) * csw.at( i ).at( j )
-                              + 2.0 * coef.at( m + 1 ) * csw2.at( i ).at( j ) )
-                            / ( 1.0 + coef.at( m ) * csw.at( i ).at( j )
-                                + coef.at( m + 1 ) * csw2.at( i ).at( j ) );
+                        const double k1 = clip_radius( p[m], r_max );
+                        const double k2 = clip_radius( p[m + 1], r_max );
+                        b[m] = k1 * ( 1.0 + k2 );
+                        b[m + 1] = k2;
                     }
-                    complex< double > second_gd = second_over - second_under;
-
-                    band_res.emplace_back( ( prime_gd + second_gd ).real() );
-                }
-                res.emplace_back( band_res );
+                    break;
             }
-            return res;
         }
 
-        double FilterParam::judge_stability_even(
-            const std::vector< double >& coef ) const
+        /* # フィルタ構造体
+         *   分母の媒介変数表示から係数列を求める
+         *
+         * # 引数
+         * vector<double>& param : 媒介変数(a0, a1, ..., 分母の媒介変数)
+         * PoleForm form : 分母の媒介変数表示
+         * double r_max : 半径・反射係数の上限(0 < r_max < 1)
+         * # 返り値
+         * vector<double> coef : 安定な係数列
+         */
+        std::vector< double > FilterParam::pole_param_to_coef(
+            const std::vector< double >& param, PoleForm form, double r_max ) const
         {
-            double penalty = 0.0;
+            check_coef_size( param );
+            check_pole_radius( r_max );
+            std::vector< double > coef( param.size() );
+            map_pole_param( param.data(), coef.data(), form, r_max );
+            return coef;
+        }
 
-            for ( unsigned int n = n_order + 1; n < this->opt_order(); n += 2 )
+        /* # フィルタ構造体
+         *   分母の媒介変数表示から係数列を一括で求める
+         *   出力先は大きさが合っていれば再確保しないため，世代ごとに使い回すことを想定する
+         *
+         * # 引数
+         * vector<vector<double>>& params : 媒介変数の配列
+         * PoleForm form : 分母の媒介変数表示
+         * double r_max : 半径・反射係数の上限(0 < r_max < 1)
+         * vector<vector<double>>& coefs : 係数列の出力先
+         */
+        void FilterParam::pole_param_to_coef_batch(
+            const std::vector< std::vector< double > >& params,
+            PoleForm form,
+            double r_max,
+            std::vector< std::vector< double > >& coefs ) const
+        {
+            check_pole_radius( r_max );
+            coefs.resize( params.size() );
+            for ( std::size_t c = 0; c < params.size(); ++c )
             {
-                if ( std::abs( coef.at( n + 1 ) ) >= 1.0
-                     || coef.at( n + 1 ) <= std::abs( coef.at( n ) ) - 1.0 )
-                {
-                    penalty += coef.at( n ) * coef.at( n )
-                               + coef.at( n + 1 ) * coef.at( n + 1 );
-                }
+                check_coef_size( params[c] );
+                coefs[c].resize( params[c].size() );
+                map_pole_param( params[c].data(), coefs[c].data(), form, r_max );
             }
-            return penalty;
         }
 
-        double FilterParam::judge_stability_odd(
-            const std::vector< double >& coef ) const
+        /* # フィルタ構造体
+         *   係数列から分母の媒介変数表示を求める(pole_param_to_coefの逆変換)
+         *   Reflectionは安定な係数列に対して厳密に戻る
+         *   Polarは共役な極の組に対して厳密で(角度は[0, π])，2つの実数の極を持つ
+         *   セクションは半径をsqrt(|b2|)，角度を0またはπとして近似する
+         *
+         * # 引数
+         * vector<double>& coef : 係数列
+         * PoleForm form : 分母の媒介変数表示
+         * # 返り値
+         * vector<double> param : 媒介変数
+         */
+        std::vector< double > FilterParam::coef_to_pole_param(
+            const std::vector< double >& coef, PoleForm form ) const
         {
-            double penalty = 0.0;
+            check_coef_size( coef );
+            std::vector< double > param( coef );
 
-            if ( std::abs( coef.at( n_order + 1 ) ) >= 1.0 )
+            const double* b = coef.data() + 1 + n_order;
+            double* p = param.data() + 1 + n_order;
+            unsigned int m = 0;
+            if ( m_order % 2 == 1 )
             {
-                penalty += coef.at( n_order + 1 ) * coef.at( n_order + 1 );
+                p[0] = form == PoleForm::Polar ? -b[0] : b[0];
+                m = 1;
             }
-            for ( unsigned int m = n_order + 2; m < opt_order(); m += 2 )
+            for ( ; m < m_order; m += 2 )
             {
-                if ( std::abs( coef.at( m + 1 ) ) >= 1.0
-                     || coef.at( m + 1 ) <= std::abs( coef.at( m ) ) - 1.0 )
+                switch ( form )
                 {
-                    penalty += coef.at( m ) * coef.at( m )
-                               + coef.at( m + 1 ) * coef.at( m + 1 );
+                    case PoleForm::Polar:
+                        {
+                            const double r = std::sqrt( std::abs( b[m + 1] ) );
+                            p[m] = r;
+                            p[m + 1] = r > 0.0
+                                           ? std::acos( std::min(
+                                               std::max( -b[m] / ( 2.0 * r ), -1.0 ), 1.0 ) )
+                                           : 0.0;
+                            break;
+                        }
+                    case PoleForm::Reflection:
+                    default:
+                        p[m] = b[m] / ( 1.0 + b[m + 1] );
+                        p[m + 1] = b[m + 1];
+                        break;
                 }
             }
-
-            return penalty;
+            return param;
         }
 
         /* # フィルタ構造体
-         *   ペナルティ関数法による目的関数値を計算する
+         *   分母の媒介変数表示で目的関数値を計算する
+         *   写した係数列は常に安定なため，安定性の判別を省く(評価値のキャッシュは用いない)
+         *   安定な係数列に対するevaluateと同じ値となる
          *
+         * # 引数
+         * vector<double>& param : 媒介変数
+         * PoleForm form : 分母の媒介変数表示
+         * double r_max : 半径・反射係数の上限(0 < r_max < 1)
          */
-        double FilterParam::evaluate( const std::vector< double >& coef ) const
+        double FilterParam::evaluate_pole_param(
+            const std::vector< double >& param, PoleForm form, double r_max ) const
         {
-            using std::complex;
-            using std::vector;
+            return evaluate_full( pole_param_to_coef( param, form, r_max ), *stable_objective_table );
+        }
+
+        /* # フィルタ構造体
+         *   分母の媒介変数表示で複数の候補の目的関数値を一括で計算する
+         *   (evaluate_batchと同じタイル分割で，安定性の判別を省く)
+         */
+        std::vector< double > FilterParam::evaluate_pole_param_batch(
+            const std::vector< std::vector< double > >& params, PoleForm form, double r_max ) const
+        {
+            std::vector< std::vector< double > > coefs;
+            pole_param_to_coef_batch( params, form, r_max, coefs );
+
+            std::vector< double > values( coefs.size(), 0.0 );
+            std::vector< std::size_t > pending( coefs.size() );
+            for ( std::size_t c = 0; c < coefs.size(); ++c )
+            {
+                pending[c] = c;
+            }
+            evaluate_tiles( coefs, pending, values, *stable_objective_table );
+            return values;
+        }
 
-            constexpr double cs = 100.0;    //安定性のペナルティの重み
-            constexpr double ct = 100.0;    //振幅隆起のペナルティの重み
+        /* # フィルタ構造体
+         *   分母の媒介変数表示の初期値を一様乱数で作る
+         *   分母は半径・反射係数を[0, r_max)または(-r_max, r_max)，角度を[0, π)から選ぶ
+         *
+         * # 引数
+         * double a0 : 利得の範囲
+         * double a : 分子の係数の範囲
+         * PoleForm form : 分母の媒介変数表示
+         * double r_max : 半径・反射係数の上限(0 < r_max < 1)
+         */
+        std::vector< double > FilterParam::init_pole_param(
+            const double a0, const double a, PoleForm form, double r_max ) const
+        {
+            using std::uniform_real_distribution;
 
-            double max_error = 0.0;    //最大誤差
-            double max_riple = 0.0;    //振幅隆起のペナルティの値
+            check_pole_radius( r_max );
+            thread_local std::random_device rnd;
+            thread_local std::mt19937 mt( rnd() );
+            uniform_real_distribution<> a0_range( -std::abs( a0 ), std::abs( a0 ) );
+            uniform_real_distribution<> a_range( -std::abs( a ), std::abs( a ) );
+            uniform_real_distribution<> signed_radius( -r_max, r_max );
+            uniform_real_distribution<> radius( 0.0, r_max );
+            uniform_real_distribution<> angle( 0.0, M_PI );
 
-            double penalty_stability = judge_stability( coef );
-            vector< vector< complex< double > > > freq = freq_res( coef );
+            std::vector< double > param;
+            param.reserve( opt_order() );
 
-            for ( unsigned int i = 0; i < bands.size();
-                  ++i )    // 周波数帯域のループ
+            param.emplace_back( a0_range( mt ) );
+            for ( unsigned int n = 0; n < n_order; ++n )
             {
-                for ( unsigned int j = 0; j < csw.at( i ).size();
-                      ++j )    // 周波数帯域内の分割数によるループ
+                param.emplace_back( a_range( mt ) );
+            }
+            if ( ( m_order % 2 ) == 1 )
+            {
+                param.emplace_back( signed_radius( mt ) );
+            }
+            for ( unsigned int m = m_order % 2; m < m_order; m += 2 )
+            {
+                if ( form == PoleForm::Polar )
                 {
-                    switch ( bands.at( i ).type() )
-                    {
-                        case BandType::Pass:
-                        case BandType::Stop:
-                            {
-                                double error = std::abs(
-                                    desire_res.at( i ).at( j )
-                                    - freq.at( i ).at( j ) );
-                                if ( max_error < error )
-                                {
-                                    max_error = error;
-                                }
-                                break;
-                            }
-                        case BandType::Transition:
-                            {
-                                double current_riple =
-                                    std::abs( freq.at( i ).at( j ) );
-                                if ( current_riple > threshold_riple
-                                     && current_riple > max_riple )
-                                {
-                                    max_riple = current_riple;
-                                }
-                                break;
-                            }
-                        default:
-                            {
-                                fprintf(
-                                    stderr, "Error: [%s l.%d]Undefined band.\n",
-                                    __FILE__, __LINE__ );
-                                exit( EXIT_FAILURE );
-                            }
-                    }
+                    param.emplace_back( radius( mt ) );
+                    param.emplace_back( angle( mt ) );
+                }
+                else
+                {
+                    param.emplace_back( signed_radius( mt ) );
+                    param.emplace_back( signed_radius( mt ) );
                 }
             }
-            return (
-                max_error + ct * max_riple * max_riple
-                + cs * penalty_stability );
+            return param;
         }
 
         std::vector< double > FilterParam::init_coef(
@@ -1129,6 +3365,8 @@ namespace filter
         /* # フィルタ構造体
          *   振幅特性図の描画
          * 	 leftとrightで描画範囲の指定[0:0.5]
+         *   gnuplotがあればfilenameに描画する
+         *   (データとスクリプトは一時ファイルに書き出し，描画後に削除する)
          *
          * # 引数
          * vector<double> &coef : 係数列
@@ -1143,104 +3381,26 @@ namespace filter
             const double left,
             const double right ) const
         {
-            BandParam range( BandType::Pass, left, right );
-            FilterParam fparam( n_order, m_order, range, 1000, 0, 5.0 );
-            auto freq_res = fparam.freq_res( coef );
-
-            constexpr double dpi = 2.0 * M_PI / 1000.0;    //固定値の事前計算
-            const double x_step = ( right - left ) * dpi;
-
-            // gnuplotで出力
-            FILE* gp = popen( "gnuplot -persist", "w" );
-            fprintf( gp, "set terminal pngcairo size 1280, 960\n" );
-            fprintf( gp, "set output '%s'\n", filename.c_str() );
-            fprintf( gp, "set grid\n" );
-            fprintf(
-                gp,
-                "set xlabel 'Normalized angular frequency'\n" );    //正規化角周波数
-            fprintf( gp, "set ylabel 'Amplitude'\n" );
-            fprintf( gp, "set key    font 'Times New Roman,15'\n" );
-            fprintf( gp, "set xlabel font 'Times New Roman,20'\n" );
-            fprintf( gp, "set ylabel font 'Times New Roman,20'\n" );
-            fprintf( gp, "set tics   font 'Times New Roman,15'\n" );
-            fprintf(
-                gp, "set xrange [%f:%f]\n", left * 2.0 * M_PI,
-                right * 2.0 * M_PI );
-            fprintf( gp, "set xtics 0, 0.1*pi, pi\n" );
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wformat"
-            fprintf( gp, "set format x '%.1Pπ'\n" );
-#pragma GCC diagnostic pop
-            fprintf( gp, "set lmargin 20\n" );
-            fprintf( gp, "set bmargin 10\n" );
-            fprintf( gp, "plot '-' with lines title \"\n" );
-
-            for ( auto band_res : freq_res )
-            {
-                for ( unsigned int i = 0; i < band_res.size(); i++ )
-                {
-                    fprintf(
-                        gp, "%f %f\n", left * 2.0 * M_PI + i * x_step,
-                        abs( band_res.at( i ) ) );
-                }
-            }
-
-            fprintf( gp, "e\n" );
-
-            pclose( gp );
+            BandParam range( BandType::Pass, left, right );    // 描画範囲の検査
+            ResponseExporter exporter( range.left(), range.right(), 1001 );
+            exporter.add( "", n_order, m_order, coef );
+            exporter.plot( std::vector< std::string > { filename }, ExportColumn::Amplitude );
         }
 
+        /* # フィルタ構造体
+         *   振幅特性図(dB)の描画
+         *   gprint_ampと同様
+         */
         void FilterParam::gprint_mag(
             const std::vector< double >& coef,
             const std::string& filename,
             const double left,
             const double right ) const
         {
-            BandParam range( BandType::Pass, left, right );
-            FilterParam fparam( n_order, m_order, range, 1000, 0, 5.0 );
-            auto freq_res = fparam.freq_res( coef );
-
-            constexpr double dpi = 2.0 * M_PI / 1000.0;    //固定値の事前計算
-            const double x_step = ( right - left ) * dpi;
-
-            // gnuplotで出力
-            FILE* gp = popen( "gnuplot -persist", "w" );
-            fprintf( gp, "set terminal pngcairo size 1280, 960\n" );
-            fprintf( gp, "set output '%s'\n", filename.c_str() );
-            fprintf( gp, "set grid\n" );
-            fprintf(
-                gp,
-                "set xlabel 'Normalized angular frequency'\n" );    //正規化角周波数
-            fprintf( gp, "set ylabel 'Magnitude[dB]'\n" );
-            fprintf( gp, "set key    font 'Times New Roman,15'\n" );
-            fprintf( gp, "set xlabel font 'Times New Roman,20'\n" );
-            fprintf( gp, "set ylabel font 'Times New Roman,20'\n" );
-            fprintf( gp, "set tics   font 'Times New Roman,15'\n" );
-            fprintf(
-                gp, "set xrange [%f:%f]\n", left * 2.0 * M_PI,
-                right * 2.0 * M_PI );
-            fprintf( gp, "set xtics 0, 0.1*pi, pi\n" );
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wformat"
-            fprintf( gp, "set format x '%.1Pπ'\n" );
-#pragma GCC diagnostic pop
-            fprintf( gp, "set lmargin 20\n" );
-            fprintf( gp, "set bmargin 10\n" );
-            fprintf( gp, "plot '-' with lines title \"\n" );
-
-            for ( auto band_res : freq_res )
-            {
-                for ( unsigned int i = 0; i < band_res.size(); i++ )
-                {
-                    fprintf(
-                        gp, "%f %f\n", left * 2.0 * M_PI + i * x_step,
-                        20 * log10( abs( band_res.at( i ) ) ) );
-                }
-            }
-
-            fprintf( gp, "e\n" );
-
-            pclose( gp );
+            BandParam range( BandType::Pass, left, right );    // 描画範囲の検査
+            ResponseExporter exporter( range.left(), range.right(), 1001 );
+            exporter.add( "", n_order, m_order, coef );
+            exporter.plot( std::vector< std::string > { filename }, ExportColumn::MagnitudeDb );
         }
 
 
@@ -1264,7 +3424,7 @@ namespace filter
             constexpr double acc = 1.0e-10;    // 1.0×10^-10≒0とし、これを基準に場合分けを行う
 
             std::vector< complex< double > > pole;
-            pole.reserve( 2 * m_order );
+            pole.reserve( m_order );
 
             for ( unsigned int m = n_order + 1; m < opt_order(); m += 2 )
             {
@@ -1299,7 +3459,7 @@ namespace filter
             const double acc = 1.0e-10;    // 1.0×10^-10≒0とし、これを基準に場合分けを行う
 
             std::vector< complex< double > > pole;
-            pole.reserve( 2 * m_order + 1 );
+            pole.reserve( m_order );
 
             pole.emplace_back( -coef.at( n_order + 1 ) );
 
@@ -1336,7 +3496,7 @@ namespace filter
             const double acc = 1.0e-10;    // 1.0×10^-10≒0とし、これを基準に場合分けを行う
 
             std::vector< complex< double > > zero;
-            zero.reserve( 2 * n_order );
+            zero.reserve( n_order );
 
             for ( unsigned int n = 1; n < n_order; n += 2 )
             {
@@ -1371,7 +3531,7 @@ namespace filter
             const double acc = 1.0e-10;    // 1.0×10^-10≒0とし、これを基準に場合分けを行う
 
             std::vector< complex< double > > zero;
-            zero.reserve( 2 * n_order + 1 );
+            zero.reserve( n_order );
 
             zero.emplace_back( -coef.at( 1 ) );
 
@@ -1399,6 +3559,67 @@ namespace filter
             return zero;
         }
 
+        /* # フィルタ構造体
+         *   極・零点の一括計算の実処理
+         *   係数列のうち[first, first + order)の範囲を
+         *   (1次セクション, 2次セクション, ...)として解く
+         *
+         * # 引数
+         * vector<vector<double>>& coefs : 係数列の配列
+         * unsigned int first : 対象の係数の先頭位置
+         * unsigned int order : 根の数(多項式の次数)
+         * RootBuffer& roots : 出力先
+         * bool with_radius : 最大根半径を計算するか
+         */
+        void FilterParam::root_batch(
+            const std::vector< std::vector< double > >& coefs,
+            const unsigned int first,
+            const unsigned int order,
+            RootBuffer& roots,
+            const bool with_radius ) const
+        {
+            roots.resize( coefs.size(), order, with_radius );
+
+            const unsigned int odd = order % 2;
+            for ( std::size_t c = 0; c < coefs.size(); ++c )
+            {
+                if ( coefs[c].size() != opt_order() )
+                {
+                    fprintf(
+                        stderr,
+                        "Error: [%s l.%d]Size of coefficients is illegal.(index "
+                        ": %llu, size : %llu, expected : %u)\n",
+                        __FILE__, __LINE__,
+                        static_cast< unsigned long long >( c ),
+                        static_cast< unsigned long long >( coefs[c].size() ),
+                        opt_order() );
+                    exit( EXIT_FAILURE );
+                }
+
+                const double* coef = coefs[c].data() + first;
+                double* re = roots.real.data() + c * order;
+                double* im = roots.imag.data() + c * order;
+
+                if ( odd == 1 )
+                {
+                    re[0] = -coef[0];
+                    im[0] = 0.0;
+                }
+                solve_sections( coef + odd, order / 2, re + odd, im + odd );
+
+                if ( with_radius )
+                {
+                    double max_norm = 0.0;
+                    for ( unsigned int k = 0; k < order; ++k )
+                    {
+                        const double norm = re[k] * re[k] + im[k] * im[k];
+                        max_norm = norm > max_norm ? norm : max_norm;
+                    }
+                    roots.radius[c] = std::sqrt( max_norm );
+                }
+            }
+        }
+
     }    // namespace iir
 }    // namespace filter
 
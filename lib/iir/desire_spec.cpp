@@ -0,0 +1,87 @@
+/*
+ * desire_spec.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#include "desire_spec.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace filter
+{
+    FILE* fileopen( const std::string&, const char, const std::string&, const int );
+
+    namespace iir
+    {
+        namespace
+        {
+            const char spec_magic[8] = { 'F', 'P', 'S', 'P', 'E', 'C', '0', '1' };
+        }    // namespace
+
+        /* # 表形式の所望特性ファイル
+         *   ファイルを読み取り専用でmmapし，ヘッダを検査する
+         *   列は先頭から順に1回ずつ読むことを想定し，先読みを指示する
+         *
+         * # 引数
+         * string& path : ファイルのパス
+         */
+        MappedSpec::MappedSpec( const std::string& path )
+            : file( path ), npoint( 0 ), column( nullptr )
+        {
+            std::uint64_t count = 0;
+            if ( file.size() >= header_bytes )
+            {
+                std::memcpy( &count, file.data() + sizeof( spec_magic ), sizeof( count ) );
+            }
+            if ( file.size() < header_bytes
+                 || std::memcmp( file.data(), spec_magic, sizeof( spec_magic ) ) != 0
+                 || count == 0
+                 || count > ( file.size() - header_bytes ) / ( 4 * sizeof( double ) ) )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Format of spec file is illegal.(file name : %s)\n",
+                    __FILE__, __LINE__, path.c_str() );
+                exit( EXIT_FAILURE );
+            }
+            file.advise_sequential();
+            npoint = static_cast< std::size_t >( count );
+            column = reinterpret_cast< const double* >( file.data() + header_bytes );
+        }
+
+        /* # 表形式の所望特性ファイル
+         *   所望特性の表をMappedSpecで読める形式で書き出す
+         *
+         * # 引数
+         * string& path : ファイルのパス
+         * double* freq, magnitude, phase, weight : 各列(count点)
+         * size_t count : 点数
+         */
+        void write_desire_spec(
+            const std::string& path,
+            const double* freq,
+            const double* magnitude,
+            const double* phase,
+            const double* weight,
+            std::size_t count )
+        {
+            FILE* fp = fileopen( path, 'w', __FILE__, __LINE__ );
+
+            const std::uint64_t header = count;
+            fwrite( spec_magic, 1, sizeof( spec_magic ), fp );
+            fwrite( &header, sizeof( std::uint64_t ), 1, fp );
+            fwrite( freq, sizeof( double ), count, fp );
+            fwrite( magnitude, sizeof( double ), count, fp );
+            fwrite( phase, sizeof( double ), count, fp );
+            fwrite( weight, sizeof( double ), count, fp );
+
+            fclose( fp );
+        }
+
+    }    // namespace iir
+}    // namespace filter
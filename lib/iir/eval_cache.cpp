@@ -0,0 +1,245 @@
+/*
+ * eval_cache.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#include "eval_cache.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace filter
+{
+    namespace iir
+    {
+
+        /* # セクション応答のキャッシュ
+         *
+         * # 引数
+         * size_t input_capacity : 保持するセクションの最大数(1以上)
+         */
+        SectionCache::SectionCache( std::size_t input_capacity )
+            : capacity( input_capacity )
+        {
+            if ( capacity == 0 )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Capacity of cache must be positive.\n",
+                    __FILE__, __LINE__ );
+                exit( EXIT_FAILURE );
+            }
+            table.reserve( capacity );
+        }
+
+        SectionCache::~SectionCache() = default;
+
+        /* # セクション応答のキャッシュ
+         *   係数の組に対応する周波数グリッド上の値を探す
+         *
+         * # 返り値
+         * shared_ptr<const Factor> factor : 見つからない場合はnullptr
+         */
+        std::shared_ptr< const SectionCache::Factor >
+        SectionCache::find( double c1, double c2 )
+        {
+            const Key key { double_bits( c1 ), double_bits( c2 ) };
+
+            std::lock_guard< std::mutex > lock( mtx );
+            auto it = table.find( key );
+            if ( it == table.end() )
+            {
+                ++stat.misses;
+                return nullptr;
+            }
+            ++stat.hits;
+            lru.splice( lru.begin(), lru, it->second.second );
+            return it->second.first;
+        }
+
+        /* # セクション応答のキャッシュ
+         *   計算した値を登録する
+         *   既に同じキーが登録されている場合は，そちらを返す
+         *
+         * # 返り値
+         * shared_ptr<const Factor> factor : キャッシュに保持されている値
+         */
+        std::shared_ptr< const SectionCache::Factor >
+        SectionCache::insert( double c1, double c2, Factor&& factor )
+        {
+            const Key key { double_bits( c1 ), double_bits( c2 ) };
+            auto value = std::make_shared< const Factor >( std::move( factor ) );
+
+            std::lock_guard< std::mutex > lock( mtx );
+            auto it = table.find( key );
+            if ( it != table.end() )
+            {
+                return it->second.first;
+            }
+
+            if ( table.size() >= capacity )
+            {
+                table.erase( lru.back() );
+                lru.pop_back();
+                ++stat.evictions;
+            }
+            lru.push_front( key );
+            table.emplace( key, Entry( value, lru.begin() ) );
+            return value;
+        }
+
+        /* # セクション応答のキャッシュ
+         *   全要素を破棄する(統計情報は保持する)
+         *   集団の世代交代ごとに呼び出すことを想定する
+         */
+        void SectionCache::clear()
+        {
+            std::lock_guard< std::mutex > lock( mtx );
+            table.clear();
+            lru.clear();
+        }
+
+        CacheStats SectionCache::stats() const
+        {
+            std::lock_guard< std::mutex > lock( mtx );
+            CacheStats current = stat;
+            current.entries = table.size();
+            return current;
+        }
+
+        /* # 評価値のキャッシュ
+         *
+         * # 引数
+         * size_t input_capacity : 保持する係数列の最大数(1以上)
+         *                         シャードごとの容量の和が丁度この値になるよう分割される
+         */
+        ResultCache::ResultCache( std::size_t input_capacity )
+            : capacity( input_capacity ),
+              nshard( input_capacity < max_shard ? input_capacity : max_shard ),
+              shards( new Shard[nshard] )
+        {
+            if ( capacity == 0 )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Capacity of cache must be positive.\n",
+                    __FILE__, __LINE__ );
+                exit( EXIT_FAILURE );
+            }
+            for ( std::size_t i = 0; i < nshard; ++i )
+            {
+                shards[i].capacity = capacity / nshard + ( i < capacity % nshard ? 1 : 0 );
+            }
+        }
+
+        ResultCache::~ResultCache() = default;
+
+        /* # 評価値のキャッシュ
+         *   係数列のビット列のハッシュ値(FNV-1aを64bit単位に適用し，最後に混合する)
+         */
+        std::uint64_t ResultCache::hash( const std::vector< double >& coef )
+        {
+            std::uint64_t h = 0xcbf29ce484222325ULL;
+            for ( const double c : coef )
+            {
+                h = ( h ^ double_bits( c ) ) * 0x100000001b3ULL;
+            }
+            return mix_bits( h ^ coef.size() );
+        }
+
+        /* # 評価値のキャッシュ
+         *   係数列に対応する目的関数値を探す
+         *
+         * # 引数
+         * vector<double>& coef : 係数列
+         * double& value : 見つかった場合の目的関数値の出力先
+         * # 返り値
+         * bool found : 見つかった場合true
+         */
+        bool ResultCache::find( const std::vector< double >& coef, double& value )
+        {
+            const std::uint64_t h = hash( coef );
+            Shard& shard = select( h );
+
+            std::lock_guard< std::mutex > lock( shard.mtx );
+            auto it = shard.table.find( h );
+            if ( it == shard.table.end()
+                 || it->second->coef.size() != coef.size()
+                 || std::memcmp(
+                        it->second->coef.data(), coef.data(),
+                        coef.size() * sizeof( double ) )
+                        != 0 )
+            {
+                ++shard.stat.misses;
+                return false;
+            }
+            ++shard.stat.hits;
+            shard.lru.splice( shard.lru.begin(), shard.lru, it->second );
+            value = it->second->value;
+            return true;
+        }
+
+        /* # 評価値のキャッシュ
+         *   目的関数値を登録する
+         *   ハッシュ値が衝突した場合は新しい係数列で上書きする
+         */
+        void ResultCache::insert( const std::vector< double >& coef, double value )
+        {
+            const std::uint64_t h = hash( coef );
+            Shard& shard = select( h );
+
+            std::lock_guard< std::mutex > lock( shard.mtx );
+            auto it = shard.table.find( h );
+            if ( it != shard.table.end() )
+            {
+                it->second->coef = coef;
+                it->second->value = value;
+                shard.lru.splice( shard.lru.begin(), shard.lru, it->second );
+                return;
+            }
+
+            if ( shard.table.size() >= shard.capacity )
+            {
+                shard.table.erase( shard.lru.back().hash );
+                shard.lru.pop_back();
+                ++shard.stat.evictions;
+            }
+            shard.lru.push_front( Node { h, coef, value } );
+            shard.table.emplace( h, shard.lru.begin() );
+        }
+
+        /* # 評価値のキャッシュ
+         *   全要素を破棄する(統計情報は保持する)
+         */
+        void ResultCache::clear()
+        {
+            for ( std::size_t i = 0; i < nshard; ++i )
+            {
+                std::lock_guard< std::mutex > lock( shards[i].mtx );
+                shards[i].table.clear();
+                shards[i].lru.clear();
+            }
+        }
+
+        /* # 評価値のキャッシュ
+         *   全シャードの統計情報を合計する
+         */
+        CacheStats ResultCache::stats() const
+        {
+            CacheStats total;
+            for ( std::size_t i = 0; i < nshard; ++i )
+            {
+                std::lock_guard< std::mutex > lock( shards[i].mtx );
+                total.hits += shards[i].stat.hits;
+                total.misses += shards[i].stat.misses;
+                total.evictions += shards[i].stat.evictions;
+                total.entries += shards[i].table.size();
+            }
+            return total;
+        }
+
+    }    // namespace iir
+}    // namespace filter
@@ -0,0 +1,124 @@
+/*
+ * fft.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#define _USE_MATH_DEFINES
+
+#include "fft.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace filter
+{
+    /* # 実数列の高速フーリエ変換
+     *
+     * # 引数
+     * size_t input_npoint : 点数N(2のべき乗)
+     */
+    RealFFT::RealFFT( std::size_t input_npoint ) : npoint( input_npoint )
+    {
+        if ( !is_pow2( npoint ) )
+        {
+            fprintf(
+                stderr,
+                "Error: [%s l.%d]FFT size must be a power of two.(size : %llu)\n",
+                __FILE__, __LINE__, static_cast< unsigned long long >( npoint ) );
+            exit( EXIT_FAILURE );
+        }
+
+        const std::size_t half = npoint / 2;
+        twiddle.resize( half );
+        for ( std::size_t k = 0; k < half; ++k )
+        {
+            twiddle[k] = std::polar(
+                1.0,
+                -2.0 * M_PI * static_cast< double >( k ) / static_cast< double >( npoint ) );
+        }
+
+        unsigned int nbit = 0;
+        while ( ( std::size_t( 1 ) << nbit ) < half )
+        {
+            ++nbit;
+        }
+        bitrev.resize( half );
+        for ( std::size_t k = 0; k < half; ++k )
+        {
+            std::size_t r = 0;
+            for ( unsigned int b = 0; b < nbit; ++b )
+            {
+                r |= ( ( k >> b ) & 1 ) << ( nbit - 1 - b );
+            }
+            bitrev[k] = r;
+        }
+    }
+
+    RealFFT::~RealFFT() = default;
+
+    /* # 実数列の高速フーリエ変換
+     *   count < Nの場合は残りを0とみなす(ゼロ詰め)
+     *
+     * # 引数
+     * double* input : 入力(count点)
+     * size_t count : 入力の点数(N以下)
+     * complex<double>* output : 出力先(N/2 + 1点)
+     */
+    void RealFFT::forward(
+        const double* input, std::size_t count, std::complex< double >* output ) const
+    {
+        using std::complex;
+        const std::size_t half = npoint / 2;
+        if ( count > npoint )
+        {
+            fprintf(
+                stderr,
+                "Error: [%s l.%d]Input is longer than FFT size.(count : %llu, size : %llu)\n",
+                __FILE__, __LINE__, static_cast< unsigned long long >( count ),
+                static_cast< unsigned long long >( npoint ) );
+            exit( EXIT_FAILURE );
+        }
+
+        // z[n] = x[2n] + j x[2n+1] をビット反転順に並べる
+        std::vector< complex< double > > z( half );
+        for ( std::size_t n = 0; n < half; ++n )
+        {
+            const double re = 2 * n < count ? input[2 * n] : 0.0;
+            const double im = 2 * n + 1 < count ? input[2 * n + 1] : 0.0;
+            z[bitrev[n]] = complex< double >( re, im );
+        }
+
+        // N/2点の複素FFT(N/2点の回転因子はN点の表の偶数番目)
+        for ( std::size_t len = 2; len <= half; len <<= 1 )
+        {
+            const std::size_t step = npoint / len;
+            const std::size_t hlen = len / 2;
+            for ( std::size_t s = 0; s < half; s += len )
+            {
+                for ( std::size_t k = 0; k < hlen; ++k )
+                {
+                    const complex< double > t = twiddle[k * step] * z[s + k + hlen];
+                    z[s + k + hlen] = z[s + k] - t;
+                    z[s + k] += t;
+                }
+            }
+        }
+
+        // 偶数番目・奇数番目の変換に分離して合成する
+        for ( std::size_t k = 0; k <= half; ++k )
+        {
+            const complex< double > zk = z[k % half];
+            const complex< double > zc = std::conj( z[( half - k ) % half] );
+            const complex< double > even = 0.5 * ( zk + zc );
+            const complex< double > odd = complex< double >( 0.0, -0.5 ) * ( zk - zc );
+            const complex< double > w =
+                k < half ? twiddle[k] : complex< double >( -1.0, 0.0 );
+            output[k] = even + w * odd;
+        }
+    }
+
+}    // namespace filter
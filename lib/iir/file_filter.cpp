@@ -0,0 +1,277 @@
+/*
+ * file_filter.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#include "file_filter.hpp"
+
+#include "biquad_cascade.hpp"
+#include "cascade_iir.hpp"
+#include "mapped_file.hpp"
+#include "parallel_for.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <unistd.h>
+
+
+namespace filter
+{
+    namespace iir
+    {
+        namespace
+        {
+            typedef void ( *ReadFunc )( const char*, double*, std::size_t );
+            typedef void ( *WriteFunc )( const double*, char*, std::size_t );
+
+            template< typename T >
+            void read_samples( const char* src, double* dst, std::size_t count )
+            {
+                const T* sample = reinterpret_cast< const T* >( src );
+                for ( std::size_t k = 0; k < count; ++k )
+                {
+                    dst[k] = static_cast< double >( sample[k] );
+                }
+            }
+
+            // 整数への書き出しは四捨五入し，範囲外は飽和させる(NaNは0)
+            template< typename T >
+            T to_sample( double value )
+            {
+                if ( std::isnan( value ) )
+                {
+                    return T( 0 );
+                }
+                const double lo = static_cast< double >( std::numeric_limits< T >::min() );
+                const double hi = static_cast< double >( std::numeric_limits< T >::max() );
+                return static_cast< T >( std::round( std::min( std::max( value, lo ), hi ) ) );
+            }
+            template<>
+            float to_sample< float >( double value )
+            {
+                return static_cast< float >( value );
+            }
+            template<>
+            double to_sample< double >( double value )
+            {
+                return value;
+            }
+
+            template< typename T >
+            void write_samples( const double* src, char* dst, std::size_t count )
+            {
+                T* sample = reinterpret_cast< T* >( dst );
+                for ( std::size_t k = 0; k < count; ++k )
+                {
+                    sample[k] = to_sample< T >( src[k] );
+                }
+            }
+
+            ReadFunc select_reader( SampleFormat format )
+            {
+                switch ( format )
+                {
+                    case SampleFormat::Int16: return &read_samples< std::int16_t >;
+                    case SampleFormat::Int32: return &read_samples< std::int32_t >;
+                    case SampleFormat::Float32: return &read_samples< float >;
+                    case SampleFormat::Float64:
+                    default: return &read_samples< double >;
+                }
+            }
+
+            WriteFunc select_writer( SampleFormat format )
+            {
+                switch ( format )
+                {
+                    case SampleFormat::Int16: return &write_samples< std::int16_t >;
+                    case SampleFormat::Int32: return &write_samples< std::int32_t >;
+                    case SampleFormat::Float32: return &write_samples< float >;
+                    case SampleFormat::Float64:
+                    default: return &write_samples< double >;
+                }
+            }
+
+            /* 1度に処理するフレーム数
+             *   変換後の倍精度の作業領域がL2キャッシュの半分に収まる大きさ
+             *   (取得できない環境ではL2 256KiBとみなす)
+             */
+            std::size_t default_chunk( unsigned int nchannel )
+            {
+                long l2 = -1;
+#if defined( _SC_LEVEL2_CACHE_SIZE )
+                l2 = sysconf( _SC_LEVEL2_CACHE_SIZE );
+#endif
+                const std::size_t l2_size =
+                    l2 > 0 ? static_cast< std::size_t >( l2 ) : 256 * 1024;
+                return std::max< std::size_t >( 64, l2_size / 2 / ( nchannel * sizeof( double ) ) );
+            }
+        }    // namespace
+
+        // 標本1つあたりのバイト数
+        std::size_t sample_bytes( SampleFormat format )
+        {
+            switch ( format )
+            {
+                case SampleFormat::Int16: return sizeof( std::int16_t );
+                case SampleFormat::Int32: return sizeof( std::int32_t );
+                case SampleFormat::Float32: return sizeof( float );
+                case SampleFormat::Float64:
+                default: return sizeof( double );
+            }
+        }
+
+        /* # 標本のデータ形式
+         *   文字列(int16, int32, float, double)からデータ形式を決める
+         */
+        SampleFormat analyze_sample_format( const std::string& input )
+        {
+            if ( input == "int16" )
+            {
+                return SampleFormat::Int16;
+            }
+            else if ( input == "int32" )
+            {
+                return SampleFormat::Int32;
+            }
+            else if ( input == "float" || input == "float32" )
+            {
+                return SampleFormat::Float32;
+            }
+            else if ( input == "double" || input == "float64" )
+            {
+                return SampleFormat::Float64;
+            }
+            fprintf(
+                stderr, "Error: [%s l.%d]Sample format is undefined.(input : \"%s\")\n",
+                __FILE__, __LINE__, input.c_str() );
+            exit( EXIT_FAILURE );
+        }
+
+        /* # ファイルのフィルタリング
+         *   区間の境界で状態を0から始めた場合の誤差が相対値toleranceまで
+         *   減衰するフレーム数
+         *   零入力応答は極の最大絶対値rに対してr^nで減衰するため ln(tol) / ln(r) とし，
+         *   重解や近接した極による過渡の増大を見込んで2倍とする
+         *
+         * # 引数
+         * double pole_radius : 極の最大絶対値
+         * double tolerance : 許容する相対誤差
+         * # 返り値
+         * size_t length : 助走のフレーム数(安定でない場合はsize_tの最大値)
+         */
+        std::size_t warmup_length( double pole_radius, double tolerance )
+        {
+            if ( !( pole_radius < 1.0 ) )
+            {
+                return std::numeric_limits< std::size_t >::max();
+            }
+            if ( pole_radius <= 0.0 )
+            {
+                return 0;    // 極が全て原点(FIR)
+            }
+            const double length = 2.0 * std::ceil( std::log( tolerance ) / std::log( pole_radius ) );
+            return length > 0.0 ? static_cast< std::size_t >( length ) : 0;
+        }
+
+        /* # ファイルのフィルタリング
+         *   入力ファイルをmmapし，FilterParamの次数と係数列で定まる縦続型IIRフィルタを
+         *   全チャネルに適用して，mmapした出力ファイルに書き出す
+         *
+         *   フレームを連続した区間に分けてスレッドに割り当て，各区間は
+         *   chunk_framesずつ倍精度に変換してBiquadCascadeで処理する
+         *   IIRフィルタは前の区間の最終状態に依存するため，2番目以降の区間は
+         *   極の最大絶対値から決めた長さだけ境界の手前から助走し，
+         *   その出力は捨てる(助走が区間の1/4を超えないように区間数を減らす)
+         *   安定でない係数列は助走できないため，1区間で処理する
+         *
+         * # 引数
+         * FilterParam& param : 次数を与えるフィルタ構造体
+         * vector<double>& coef : 係数列
+         * string& input_path, output_path : 入出力ファイルのパス(ヘッダなしの標本列)
+         * FileFilterConfig& config : 設定
+         * # 返り値
+         * FileFilterStats stats : 処理の結果
+         */
+        FileFilterStats filter_file(
+            const FilterParam& param,
+            const std::vector< double >& coef,
+            const std::string& input_path,
+            const std::string& output_path,
+            const FileFilterConfig& config )
+        {
+            const unsigned int nchannel = config.nchannel;
+            const std::size_t in_bytes = sample_bytes( config.input_format );
+            const std::size_t out_bytes = sample_bytes( config.output_format );
+
+            const MappedFile input( input_path );
+            if ( nchannel == 0 || input.size() % ( in_bytes * nchannel ) != 0 )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Size of input file is not a multiple of frame "
+                    "size.(file name : %s, size : %llu, channels : %u)\n",
+                    __FILE__, __LINE__, input_path.c_str(),
+                    static_cast< unsigned long long >( input.size() ), nchannel );
+                exit( EXIT_FAILURE );
+            }
+            input.advise_sequential();
+
+            FileFilterStats stats;
+            stats.nframe = input.size() / ( in_bytes * nchannel );
+            stats.pole_radius = 0.0;
+            if ( param.pole_order() != 0 )
+            {
+                RootBuffer poles;
+                param.pole_batch( std::vector< std::vector< double > > { coef }, poles, true );
+                stats.pole_radius = poles.radius.at( 0 );
+            }
+            stats.warmup_frames = warmup_length( stats.pole_radius, config.warmup_tolerance );
+
+            MappedFile output( output_path, stats.nframe * nchannel * out_bytes );
+
+            const std::size_t chunk =
+                config.chunk_frames != 0 ? config.chunk_frames : default_chunk( nchannel );
+            const bool stable = stats.warmup_frames != std::numeric_limits< std::size_t >::max();
+            // 内部状態が入れ替わるまでの次数分も助走に加える
+            stats.warmup_frames =
+                stable ? stats.warmup_frames + param.zero_order() + param.pole_order() : 0;
+            const std::size_t warmup = stats.warmup_frames;
+            const std::size_t min_segment =
+                stable ? std::max( chunk, 4 * warmup ) : stats.nframe;
+            const ReadFunc reader = select_reader( config.input_format );
+            const WriteFunc writer = select_writer( config.output_format );
+            const unsigned int n_order = param.zero_order();
+            const unsigned int m_order = param.pole_order();
+            char* out_data = output.data();
+
+            stats.nsegment = parallel_for(
+                stats.nframe, stable ? config.nthreads : 1, min_segment,
+                [&]( std::size_t f0, std::size_t f1, std::size_t )
+                {
+                    BiquadCascade cascade( n_order, m_order, coef, nchannel );
+                    std::vector< double > buf( chunk * nchannel );
+
+                    std::size_t t = f0 - std::min( f0, warmup );
+                    while ( t < f1 )
+                    {
+                        // 助走の範囲と出力する範囲を1つのチャンクに混ぜない
+                        const std::size_t len = std::min( chunk, ( t < f0 ? f0 : f1 ) - t );
+                        reader( input.data() + t * nchannel * in_bytes, buf.data(), len * nchannel );
+                        cascade.process( buf.data(), buf.data(), len );
+                        if ( t >= f0 )
+                        {
+                            writer( buf.data(), out_data + t * nchannel * out_bytes, len * nchannel );
+                        }
+                        t += len;
+                    }
+                } );
+            return stats;
+        }
+
+    }    // namespace iir
+}    // namespace filter
@@ -0,0 +1,347 @@
+/*
+ * freq_sweep.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#define _USE_MATH_DEFINES
+
+#include "freq_sweep.hpp"
+
+#include "parallel_for.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace filter
+{
+    namespace iir
+    {
+        namespace
+        {
+            constexpr std::size_t sweep_block = 64;    // 1ブロックの点数
+
+            /* 掃引する周波数点の与え方
+             *   配列で与えるか，(左端, 右端, 点数)から都度計算する
+             */
+            struct SweepSource
+            {
+                const double* freq;
+                double left;
+                double right;
+                std::size_t count;
+                SweepScale scale;
+
+                double at( std::size_t k ) const
+                {
+                    if ( freq != nullptr )
+                    {
+                        return freq[k];
+                    }
+                    if ( count <= 1 )
+                    {
+                        return left;
+                    }
+                    const double t =
+                        static_cast< double >( k ) / static_cast< double >( count - 1 );
+                    switch ( scale )
+                    {
+                        case SweepScale::Log: return left * std::pow( right / left, t );
+                        case SweepScale::Linear:
+                        default: return left + ( right - left ) * t;
+                    }
+                }
+            };
+
+            /* 係数列をセクション(c1, c2)の列に並べ替えたもの
+             *   1次セクションはc2 = 0とする
+             */
+            struct SectionList
+            {
+                double gain;
+                std::vector< double > c1;
+                std::vector< double > c2;
+                std::size_t nnume;    // 先頭nnume個が分子，残りが分母
+
+                SectionList(
+                    const std::vector< double >& coef,
+                    unsigned int n_order,
+                    unsigned int m_order )
+                    : gain( coef.at( 0 ) ), nnume( 0 )
+                {
+                    const unsigned int nsec = ( n_order + 1 ) / 2 + ( m_order + 1 ) / 2;
+                    c1.reserve( nsec );
+                    c2.reserve( nsec );
+                    push( coef.data() + 1, n_order );
+                    nnume = c1.size();
+                    push( coef.data() + 1 + n_order, m_order );
+                }
+
+                void push( const double* c, unsigned int order )
+                {
+                    const unsigned int odd = order % 2;
+                    if ( odd == 1 )
+                    {
+                        c1.emplace_back( c[0] );
+                        c2.emplace_back( 0.0 );
+                    }
+                    for ( unsigned int k = odd; k < order; k += 2 )
+                    {
+                        c1.emplace_back( c[k] );
+                        c2.emplace_back( c[k + 1] );
+                    }
+                }
+            };
+
+            /* 1ブロック分の周波数特性を計算する
+             *   セクション -> 点の順にループし，実数演算のみで記述するため，
+             *   点方向のループはベクトル化できる
+             */
+            void sweep_block_kernel(
+                const SectionList& sec,
+                const SweepSource& src,
+                const std::size_t k0,
+                const std::size_t n,
+                const SweepOutput& out )
+            {
+                double wr[sweep_block], wi[sweep_block];
+                double w2r[sweep_block], w2i[sweep_block];
+                double nr[sweep_block], ni[sweep_block];
+                double dr[sweep_block], di[sweep_block];
+                double gd[sweep_block];
+                const bool with_gd = out.group_delay != nullptr;
+
+                for ( std::size_t p = 0; p < n; ++p )
+                {
+                    const double ang = -2.0 * M_PI * src.at( k0 + p );
+                    wr[p] = std::cos( ang );
+                    wi[p] = std::sin( ang );
+                    w2r[p] = wr[p] * wr[p] - wi[p] * wi[p];
+                    w2i[p] = 2.0 * wr[p] * wi[p];
+                    nr[p] = 1.0;
+                    ni[p] = 0.0;
+                    dr[p] = 1.0;
+                    di[p] = 0.0;
+                    gd[p] = 0.0;
+                }
+
+                for ( std::size_t s = 0; s < sec.c1.size(); ++s )
+                {
+                    const double c1 = sec.c1[s];
+                    const double c2 = sec.c2[s];
+                    const bool nume = s < sec.nnume;
+                    double* acc_r = nume ? nr : dr;
+                    double* acc_i = nume ? ni : di;
+                    const double sign = nume ? 1.0 : -1.0;
+
+                    for ( std::size_t p = 0; p < n; ++p )
+                    {
+                        const double fr = 1.0 + c1 * wr[p] + c2 * w2r[p];
+                        const double fi = c1 * wi[p] + c2 * w2i[p];
+                        const double ar = acc_r[p] * fr - acc_i[p] * fi;
+                        const double ai = acc_r[p] * fi + acc_i[p] * fr;
+                        acc_r[p] = ar;
+                        acc_i[p] = ai;
+                    }
+                    if ( with_gd )
+                    {
+                        // セクションの群遅延 Re((c1 e^-jω + 2 c2 e^-j2ω) / F)
+                        for ( std::size_t p = 0; p < n; ++p )
+                        {
+                            const double fr = 1.0 + c1 * wr[p] + c2 * w2r[p];
+                            const double fi = c1 * wi[p] + c2 * w2i[p];
+                            const double xr = c1 * wr[p] + 2.0 * c2 * w2r[p];
+                            const double xi = c1 * wi[p] + 2.0 * c2 * w2i[p];
+                            gd[p] += sign * ( xr * fr + xi * fi ) / ( fr * fr + fi * fi );
+                        }
+                    }
+                }
+
+                for ( std::size_t p = 0; p < n; ++p )
+                {
+                    const double dd = dr[p] * dr[p] + di[p] * di[p];
+                    const double hr = sec.gain * ( nr[p] * dr[p] + ni[p] * di[p] ) / dd;
+                    const double hi = sec.gain * ( ni[p] * dr[p] - nr[p] * di[p] ) / dd;
+                    const std::size_t k = k0 + p;
+
+                    if ( out.response != nullptr )
+                    {
+                        out.response[k] = std::complex< double >( hr, hi );
+                    }
+                    if ( out.magnitude_db != nullptr )
+                    {
+                        out.magnitude_db[k] = 10.0 * std::log10( hr * hr + hi * hi );
+                    }
+                    if ( out.phase != nullptr )
+                    {
+                        out.phase[k] = std::atan2( hi, hr );
+                    }
+                    if ( with_gd )
+                    {
+                        out.group_delay[k] = gd[p];
+                    }
+                }
+            }
+
+            void sweep(
+                const unsigned int n_order,
+                const unsigned int m_order,
+                const std::vector< double >& coef,
+                const SweepSource& src,
+                const SweepOutput& out,
+                const unsigned int nthreads )
+            {
+                if ( coef.size() != 1 + n_order + m_order )
+                {
+                    fprintf(
+                        stderr,
+                        "Error: [%s l.%d]Size of coefficients is illegal.(size : "
+                        "%llu, expected : %u)\n",
+                        __FILE__, __LINE__,
+                        static_cast< unsigned long long >( coef.size() ),
+                        1 + n_order + m_order );
+                    exit( EXIT_FAILURE );
+                }
+
+                const SectionList sec( coef, n_order, m_order );
+                const std::size_t nblock = ( src.count + sweep_block - 1 ) / sweep_block;
+                parallel_for(
+                    nblock, nthreads, 256,
+                    [&]( std::size_t b0, std::size_t b1, std::size_t )
+                    {
+                        for ( std::size_t b = b0; b < b1; ++b )
+                        {
+                            const std::size_t k0 = b * sweep_block;
+                            const std::size_t n =
+                                std::min( sweep_block, src.count - k0 );
+                            sweep_block_kernel( sec, src, k0, n, out );
+                        }
+                    } );
+            }
+
+            void check_range( double left, double right, SweepScale scale )
+            {
+                if ( left > right || ( scale == SweepScale::Log && left <= 0.0 ) )
+                {
+                    fprintf(
+                        stderr,
+                        "Error: [%s l.%d]Sweep range is illegal(left :%6.3f, "
+                        "right :%6.3f)\n",
+                        __FILE__, __LINE__, left, right );
+                    exit( EXIT_FAILURE );
+                }
+            }
+        }    // namespace
+
+        /* セクションの積を展開して直接型の多項式にする
+         *   奇数次の場合は先頭を1次セクション(1 + c z^-1)とし，
+         *   残りを2次セクション(1 + c1 z^-1 + c2 z^-2)とする
+         *
+         * # 引数
+         * double* coef : セクションの係数(分子ならa1,..., 分母ならb1,...)
+         * unsigned int order : 次数
+         * # 返り値
+         * vector<double> poly : z^-1の昇べきの係数(order + 1個，poly[0] = 1)
+         */
+        std::vector< double > expand_sections( const double* coef, unsigned int order )
+        {
+            std::vector< double > poly( order + 1, 0.0 );
+            poly[0] = 1.0;
+            unsigned int degree = 0;
+
+            const unsigned int odd = order % 2;
+            if ( odd == 1 )
+            {
+                poly[1] = coef[0];
+                degree = 1;
+            }
+            for ( unsigned int k = odd; k < order; k += 2 )
+            {
+                const double c1 = coef[k];
+                const double c2 = coef[k + 1];
+                degree += 2;
+                for ( unsigned int d = degree; d >= 1; --d )
+                {
+                    poly[d] += c1 * poly[d - 1] + ( d >= 2 ? c2 * poly[d - 2] : 0.0 );
+                }
+            }
+            return poly;
+        }
+
+        /* # 周波数掃引
+         *   掃引する正規化周波数の配列を生成する
+         *   両端を含むcount点で，線形刻みまたは対数刻みとする
+         *
+         * # 引数
+         * double left, right : 掃引範囲の正規化周波数(対数刻みの場合 left > 0)
+         * size_t count : 点数
+         * SweepScale scale : 刻み方
+         * double* freq : 出力先(count点)
+         */
+        void gen_sweep_grid(
+            double left,
+            double right,
+            std::size_t count,
+            SweepScale scale,
+            double* freq )
+        {
+            check_range( left, right, scale );
+            const SweepSource src { nullptr, left, right, count, scale };
+            for ( std::size_t k = 0; k < count; ++k )
+            {
+                freq[k] = src.at( k );
+            }
+        }
+
+        /* # 周波数掃引
+         *   FilterParamを構築せずに，任意の正規化周波数の配列で
+         *   縦続型IIRフィルタの周波数特性・振幅特性・位相特性・群遅延特性を計算する
+         *   64点ごとのブロックに分け，ブロック内は点方向にベクトル化できる形で計算する
+         *   nthreadsが1以外の場合，ブロックを複数スレッドに分配する
+         *
+         * # 引数
+         * unsigned int n_order, m_order : 分子・分母の次数
+         * vector<double>& coef : 係数列(a0, a1, a2[0], a2[1],..., b1, b2[0], b2[1],...)
+         * double* freq : 正規化周波数の配列
+         * size_t count : 点数
+         * SweepOutput& out : 出力先(nullptrの項目は計算しない)
+         * unsigned int nthreads : スレッド数(0でハードウェアのスレッド数)
+         */
+        void sweep_response(
+            unsigned int n_order,
+            unsigned int m_order,
+            const std::vector< double >& coef,
+            const double* freq,
+            std::size_t count,
+            const SweepOutput& out,
+            unsigned int nthreads )
+        {
+            const SweepSource src { freq, 0.0, 0.0, count, SweepScale::Linear };
+            sweep( n_order, m_order, coef, src, out, nthreads );
+        }
+
+        /* # 周波数掃引
+         *   (左端, 右端, 点数)で与えた線形・対数刻みの掃引
+         *   周波数点はgen_sweep_gridと同じ値を都度計算するため，配列は不要
+         */
+        void sweep_response(
+            unsigned int n_order,
+            unsigned int m_order,
+            const std::vector< double >& coef,
+            double left,
+            double right,
+            std::size_t count,
+            SweepScale scale,
+            const SweepOutput& out,
+            unsigned int nthreads )
+        {
+            check_range( left, right, scale );
+            const SweepSource src { nullptr, left, right, count, scale };
+            sweep( n_order, m_order, coef, src, out, nthreads );
+        }
+
+    }    // namespace iir
+}    // namespace filter
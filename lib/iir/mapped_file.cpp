@@ -0,0 +1,104 @@
+/*
+ * mapped_file.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#include "mapped_file.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace filter
+{
+    /* # メモリマップしたファイル
+     *   既存のファイルを読み取り専用でマップする
+     *   空のファイルはマップせず，size() == 0とする
+     *
+     * # 引数
+     * string& path : ファイルのパス
+     */
+    MappedFile::MappedFile( const std::string& path ) : addr( nullptr ), length( 0 )
+    {
+        const int fd = open( path.c_str(), O_RDONLY );
+        struct stat st;
+        if ( fd < 0 || fstat( fd, &st ) != 0 )
+        {
+            fprintf(
+                stderr, "Error: [%s l.%d]Can't open file.(file name : %s, mode : r)\n",
+                __FILE__, __LINE__, path.c_str() );
+            exit( EXIT_FAILURE );
+        }
+        length = static_cast< std::size_t >( st.st_size );
+
+        if ( length != 0 )
+        {
+            addr = mmap( nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0 );
+        }
+        close( fd );
+        if ( addr == MAP_FAILED )
+        {
+            fprintf(
+                stderr, "Error: [%s l.%d]Can't map file.(file name : %s)\n", __FILE__,
+                __LINE__, path.c_str() );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    /* # メモリマップしたファイル
+     *   ファイルをsizeバイトで作成(既存の場合は切り詰め)し，書き込み用にマップする
+     *
+     * # 引数
+     * string& path : ファイルのパス
+     * size_t size : ファイルの大きさ [byte]
+     */
+    MappedFile::MappedFile( const std::string& path, std::size_t size )
+        : addr( nullptr ), length( size )
+    {
+        const int fd = open( path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+        if ( fd < 0 || ftruncate( fd, static_cast< off_t >( length ) ) != 0 )
+        {
+            fprintf(
+                stderr, "Error: [%s l.%d]Can't open file.(file name : %s, mode : w)\n",
+                __FILE__, __LINE__, path.c_str() );
+            exit( EXIT_FAILURE );
+        }
+
+        if ( length != 0 )
+        {
+            addr = mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        }
+        close( fd );
+        if ( addr == MAP_FAILED )
+        {
+            fprintf(
+                stderr, "Error: [%s l.%d]Can't map file.(file name : %s)\n", __FILE__,
+                __LINE__, path.c_str() );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if ( addr != nullptr )
+        {
+            munmap( addr, length );
+        }
+    }
+
+    // 先頭から順に1回ずつ読むことをOSに伝え，先読みを促す
+    void MappedFile::advise_sequential() const
+    {
+        if ( addr != nullptr )
+        {
+            madvise( addr, length, MADV_SEQUENTIAL );
+        }
+    }
+
+}    // namespace filter
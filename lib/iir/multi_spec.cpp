@@ -0,0 +1,190 @@
+/*
+ * multi_spec.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#include "multi_spec.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace filter
+{
+    namespace iir
+    {
+        namespace
+        {
+            // 統合前の1点(並べ替えの鍵は周波数，同じ周波数はビット列の順)
+            struct GridPoint
+            {
+                double angle;    // ω [rad]
+                std::complex< double > w;
+                std::complex< double > w2;
+                std::size_t spec;
+                std::size_t point;
+            };
+
+            // e^-jω, e^-j2ωのビット列による比較
+            int compare_bits( const GridPoint& x, const GridPoint& y )
+            {
+                const double xs[4] = { x.w.real(), x.w.imag(), x.w2.real(), x.w2.imag() };
+                const double ys[4] = { y.w.real(), y.w.imag(), y.w2.real(), y.w2.imag() };
+                return std::memcmp( xs, ys, sizeof( xs ) );
+            }
+
+            typedef void ( *SweepFunc )(
+                const double*,
+                unsigned int,
+                unsigned int,
+                const std::complex< double >*,
+                const std::complex< double >*,
+                std::size_t,
+                std::complex< double >* );
+
+            template< bool NOdd, bool MOdd >
+            void sweep_response(
+                const double* coef,
+                unsigned int n_order,
+                unsigned int m_order,
+                const std::complex< double >* w,
+                const std::complex< double >* w2,
+                std::size_t npoint,
+                std::complex< double >* response )
+            {
+                for ( std::size_t j = 0; j < npoint; ++j )
+                {
+                    response[j] =
+                        cascade_response_fixed< NOdd, MOdd >( coef, n_order, m_order, w[j], w2[j] );
+                }
+            }
+
+            // 次数の偶奇から特性の計算関数を選ぶ
+            SweepFunc select_sweep( unsigned int n_order, unsigned int m_order )
+            {
+                if ( n_order % 2 == 1 )
+                {
+                    return m_order % 2 == 1 ? &sweep_response< true, true >
+                                            : &sweep_response< true, false >;
+                }
+                return m_order % 2 == 1 ? &sweep_response< false, true >
+                                        : &sweep_response< false, false >;
+            }
+        }    // namespace
+
+        /* # 複数の仕様に対する評価
+         *   仕様の周波数グリッドを統合し，仕様の点から統合した点への番号を作る
+         *
+         * # 引数
+         * vector<FilterParam>& input_specs : 仕様の族(1つ以上，零点・極の数が同じ)
+         */
+        MultiSpecEvaluator::MultiSpecEvaluator( const std::vector< FilterParam >& input_specs )
+            : specs( input_specs )
+        {
+            if ( specs.empty() )
+            {
+                fprintf( stderr, "Error: [%s l.%d]No spec is given.\n", __FILE__, __LINE__ );
+                exit( EXIT_FAILURE );
+            }
+            for ( std::size_t s = 0; s < specs.size(); ++s )
+            {
+                if ( specs[s].n_order != specs[0].n_order || specs[s].m_order != specs[0].m_order )
+                {
+                    fprintf(
+                        stderr,
+                        "Error: [%s l.%d]Order of spec is different.(index : %llu, order : "
+                        "%u/%u, expected : %u/%u)\n",
+                        __FILE__, __LINE__, static_cast< unsigned long long >( s ),
+                        specs[s].n_order, specs[s].m_order, specs[0].n_order, specs[0].m_order );
+                    exit( EXIT_FAILURE );
+                }
+            }
+
+            std::vector< GridPoint > points;
+            for ( std::size_t s = 0; s < specs.size(); ++s )
+            {
+                const GridTable& grid = *specs[s].grid_table;
+                const std::complex< double >* w = grid.value.data();
+                const std::complex< double >* w2 = w + grid.npoint();
+                for ( std::size_t p = 0; p < grid.npoint(); ++p )
+                {
+                    // e^-jω の偏角の符号を反転した値がω
+                    points.push_back( GridPoint { -std::arg( w[p] ), w[p], w2[p], s, p } );
+                }
+                index.emplace_back( grid.npoint() );
+            }
+            std::sort(
+                points.begin(), points.end(),
+                []( const GridPoint& x, const GridPoint& y )
+                {
+                    if ( x.angle < y.angle || y.angle < x.angle )
+                    {
+                        return x.angle < y.angle;
+                    }
+                    return compare_bits( x, y ) < 0;
+                } );
+
+            for ( std::size_t k = 0; k < points.size(); ++k )
+            {
+                if ( k == 0 || compare_bits( points[k - 1], points[k] ) != 0 )
+                {
+                    csw.push_back( points[k].w );
+                    csw2.push_back( points[k].w2 );
+                }
+                index[points[k].spec][points[k].point] = csw.size() - 1;
+            }
+        }
+
+        MultiSpecEvaluator::~MultiSpecEvaluator() = default;
+
+        // 統合前の全点数
+        std::size_t MultiSpecEvaluator::total_points() const
+        {
+            std::size_t total = 0;
+            for ( const auto& spec_index : index )
+            {
+                total += spec_index.size();
+            }
+            return total;
+        }
+
+        /* # 複数の仕様に対する評価
+         *   統合したグリッドで特性を1回計算し，全仕様の目的関数値と最悪値を求める
+         *
+         * # 引数
+         * vector<double>& coef : 係数列
+         * # 返り値
+         * MultiSpecResult result : 仕様ごとの値と最悪値
+         */
+        MultiSpecResult MultiSpecEvaluator::evaluate( const std::vector< double >& coef ) const
+        {
+            const FilterParam& base = specs[0];
+            base.check_coef_size( coef );
+
+            std::vector< std::complex< double > > response( csw.size() );
+            select_sweep( base.n_order, base.m_order )(
+                coef.data(), base.n_order, base.m_order, csw.data(), csw2.data(), csw.size(),
+                response.data() );
+
+            MultiSpecResult result;
+            result.value.resize( specs.size() );
+            result.worst = 0.0;
+            result.worst_index = 0;
+            for ( std::size_t s = 0; s < specs.size(); ++s )
+            {
+                result.value[s] = specs[s].evaluate_indexed( coef, response.data(), index[s].data() );
+                if ( s == 0 || result.value[s] > result.worst )
+                {
+                    result.worst = result.value[s];
+                    result.worst_index = s;
+                }
+            }
+            return result;
+        }
+
+    }    // namespace iir
+}    // namespace filter
@@ -0,0 +1,458 @@
+/*
+ * response_export.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#define _USE_MATH_DEFINES
+
+#include "response_export.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace filter
+{
+    FILE* fileopen( const std::string&, const char, const std::string&, const int );
+
+    namespace iir
+    {
+        namespace
+        {
+            // execvpに失敗した子プロセスの終了コード(シェルの慣例に合わせる)
+            constexpr int gnuplot_not_found = 127;
+
+            // gnuplotの単一引用符の文字列(引用符は2つ重ねる)
+            std::string gnuplot_quote( const std::string& str )
+            {
+                std::string quoted( 1, '\'' );
+                for ( const char c : str )
+                {
+                    quoted += c;
+                    if ( c == '\'' )
+                    {
+                        quoted += '\'';
+                    }
+                }
+                quoted += '\'';
+                return quoted;
+            }
+
+            /* 固定長バッファを介したテキスト書き出し
+             *   バッファが埋まりそうになったらfwriteでまとめて書き出す
+             */
+            struct TextWriter
+            {
+                static constexpr std::size_t capacity = 1 << 16;
+                static constexpr std::size_t margin = 64;    // 1値の最大長
+
+                FILE* fp;
+                std::size_t used;
+                char buf[capacity];
+
+                explicit TextWriter( FILE* input ) : fp( input ), used( 0 ) {}
+                ~TextWriter() { flush(); }
+
+                void flush()
+                {
+                    fwrite( buf, 1, used, fp );
+                    used = 0;
+                }
+                void reserve()
+                {
+                    if ( used + margin > capacity )
+                    {
+                        flush();
+                    }
+                }
+                void put( char c )
+                {
+                    reserve();
+                    buf[used++] = c;
+                }
+                void put( const std::string& str )
+                {
+                    for ( const char c : str )
+                    {
+                        put( c );
+                    }
+                }
+                void put( double value, unsigned int precision )
+                {
+                    reserve();
+                    used += write_fixed( value, precision, buf + used );
+                }
+            };
+        }    // namespace
+
+        /* # 周波数特性の書き出し
+         *   doubleを小数点以下precision桁の固定小数点表記で書き込む
+         *   整数演算のみで変換するため，printfより高速でメモリ確保もしない
+         *   絶対値が大きい値や非有限値はsnprintfで書き込む
+         *
+         * # 引数
+         * double value : 変換する値
+         * unsigned int precision : 小数点以下の桁数(9桁以下)
+         * char* buf : 出力先(64文字以上)
+         * # 返り値
+         * size_t length : 書き込んだ文字数(終端文字は書き込まない)
+         */
+        std::size_t write_fixed( double value, unsigned int precision, char* buf )
+        {
+            static const std::uint64_t pow10[] = {
+                1ULL,         10ULL,         100ULL,
+                1000ULL,      10000ULL,      100000ULL,
+                1000000ULL,   10000000ULL,   100000000ULL,
+                1000000000ULL
+            };
+            if ( precision > 9 )
+            {
+                precision = 9;
+            }
+
+            const double scale = static_cast< double >( pow10[precision] );
+            const double magnitude = std::abs( value );
+            if ( !std::isfinite( value ) || magnitude * scale >= 9.0e15 )
+            {
+                const int len = snprintf( buf, 64, "%.*f", precision, value );
+                return len < 0 ? 0 : static_cast< std::size_t >( len );
+            }
+
+            const std::uint64_t scaled =
+                static_cast< std::uint64_t >( magnitude * scale + 0.5 );
+            std::uint64_t integer = scaled / pow10[precision];
+            std::uint64_t fraction = scaled % pow10[precision];
+
+            std::size_t len = 0;
+            if ( std::signbit( value ) && scaled != 0 )
+            {
+                buf[len++] = '-';
+            }
+
+            char digits[20];
+            std::size_t ndigit = 0;
+            do
+            {
+                digits[ndigit++] = static_cast< char >( '0' + integer % 10 );
+                integer /= 10;
+            } while ( integer != 0 );
+            while ( ndigit != 0 )
+            {
+                buf[len++] = digits[--ndigit];
+            }
+
+            if ( precision != 0 )
+            {
+                buf[len++] = '.';
+                for ( unsigned int d = precision; d != 0; --d )
+                {
+                    buf[len + d - 1] = static_cast< char >( '0' + fraction % 10 );
+                    fraction /= 10;
+                }
+                len += precision;
+            }
+            return len;
+        }
+
+        /* # 周波数特性の書き出し
+         *   gnuplotのスクリプトを実行して図を描画する
+         *   シェルを介さずにgnuplotを直接起動するため，パスに記号を含んでもよい
+         *   gnuplotが無い環境(ヘッドレスノードなど)では何もしない
+         *
+         * # 返り値
+         * bool rendered : 描画した場合true
+         */
+        bool render_gnuplot( const std::string& script_path )
+        {
+            const pid_t pid = fork();
+            if ( pid < 0 )
+            {
+                fprintf(
+                    stderr, "Warning: [%s l.%d]Can't start gnuplot.(script : %s)\n", __FILE__,
+                    __LINE__, script_path.c_str() );
+                return false;
+            }
+            if ( pid == 0 )
+            {
+                std::string program = "gnuplot";
+                std::string script = script_path;
+                char* const argv[] = { &program[0], &script[0], nullptr };
+                execvp( argv[0], argv );
+                _exit( gnuplot_not_found );
+            }
+
+            int status = 0;
+            while ( waitpid( pid, &status, 0 ) < 0 )
+            {
+                if ( errno != EINTR )
+                {
+                    return false;
+                }
+            }
+            if ( WIFEXITED( status ) && WEXITSTATUS( status ) == gnuplot_not_found )
+            {
+                fprintf(
+                    stderr,
+                    "Warning: [%s l.%d]gnuplot is not found. Skip rendering.(script "
+                    ": %s)\n",
+                    __FILE__, __LINE__, script_path.c_str() );
+                return false;
+            }
+            return WIFEXITED( status ) && WEXITSTATUS( status ) == 0;
+        }
+
+        /* # 周波数特性の書き出し
+         *
+         * # 引数
+         * double left, right : 掃引範囲の正規化周波数
+         * size_t count : 点数
+         * SweepScale scale : 刻み方
+         * unsigned int input_nthreads : 周波数特性の計算に用いるスレッド数
+         */
+        ResponseExporter::ResponseExporter(
+            double left,
+            double right,
+            std::size_t count,
+            SweepScale scale,
+            unsigned int input_nthreads )
+            : freq( count ), nthreads( input_nthreads )
+        {
+            gen_sweep_grid( left, right, count, scale, freq.data() );
+        }
+
+        ResponseExporter::~ResponseExporter() = default;
+
+        /* # 周波数特性の書き出し
+         *   設計結果を1つ追加し，周波数特性を計算する
+         *
+         * # 引数
+         * string& name : 設計結果の名前(CSVの見出しや凡例に用いる)
+         * unsigned int n_order, m_order : 分子・分母の次数
+         * vector<double>& coef : 係数列
+         */
+        void ResponseExporter::add(
+            const std::string& name,
+            unsigned int n_order,
+            unsigned int m_order,
+            const std::vector< double >& coef )
+        {
+            const std::size_t npoint = freq.size();
+            const std::size_t design = names.size();
+            names.emplace_back( name );
+            columns.resize( columns.size() + ncolumn * npoint );
+
+            std::vector< std::complex< double > > response( npoint );
+            double* amplitude = columns.data() + design * ncolumn * npoint;
+            SweepOutput out;
+            out.response = response.data();
+            out.magnitude_db = amplitude + npoint;
+            out.phase = amplitude + 2 * npoint;
+            out.group_delay = amplitude + 3 * npoint;
+            sweep_response( n_order, m_order, coef, freq.data(), npoint, out, nthreads );
+
+            for ( std::size_t k = 0; k < npoint; ++k )
+            {
+                amplitude[k] = std::abs( response[k] );
+            }
+        }
+
+        /* # 周波数特性の書き出し
+         *   全設計結果を列指向のバイナリ形式で書き出す
+         */
+        void ResponseExporter::write_binary( const std::string& path ) const
+        {
+            FILE* fp = fileopen( path, 'w', __FILE__, __LINE__ );
+
+            const char magic[8] = { 'F', 'P', 'R', 'E', 'S', 'P', '0', '1' };
+            const std::uint64_t header[3] = { names.size(), freq.size(), ncolumn };
+            fwrite( magic, 1, sizeof( magic ), fp );
+            fwrite( header, sizeof( std::uint64_t ), 3, fp );
+            fwrite( freq.data(), sizeof( double ), freq.size(), fp );
+            fwrite( columns.data(), sizeof( double ), columns.size(), fp );
+
+            fclose( fp );
+        }
+
+        /* # 周波数特性の書き出し
+         *   周波数と全設計結果の特性を1行1周波数のCSV形式で書き出す
+         *   列は freq, <name>_amp, <name>_mag, <name>_phase, <name>_gd, ...
+         */
+        void ResponseExporter::write_csv( const std::string& path ) const
+        {
+            write_text( path, ',', true );
+        }
+
+        void ResponseExporter::write_text(
+            const std::string& path, char separator, bool header ) const
+        {
+            static const char* const suffix[ncolumn] = { "_amp", "_mag", "_phase", "_gd" };
+            const std::size_t npoint = freq.size();
+
+            FILE* fp = fileopen( path, 'w', __FILE__, __LINE__ );
+            {
+                std::unique_ptr< TextWriter > writer( new TextWriter( fp ) );
+                if ( header )
+                {
+                    writer->put( "freq" );
+                    for ( const auto& name : names )
+                    {
+                        for ( unsigned int c = 0; c < ncolumn; ++c )
+                        {
+                            writer->put( separator );
+                            writer->put( name + suffix[c] );
+                        }
+                    }
+                    writer->put( '\n' );
+                }
+
+                for ( std::size_t k = 0; k < npoint; ++k )
+                {
+                    writer->put( freq[k], 9 );
+                    for ( std::size_t d = 0; d < names.size() * ncolumn; ++d )
+                    {
+                        writer->put( separator );
+                        writer->put( columns[d * npoint + k], 6 );
+                    }
+                    writer->put( '\n' );
+                }
+            }
+            fclose( fp );
+        }
+
+        /* # 周波数特性の書き出し
+         *   gnuplot用の空白区切りデータと描画スクリプトを書き出す
+         *   横軸は正規化角周波数 ω = 2πf とする
+         *
+         * # 引数
+         * string& data_path : データファイルのパス
+         * string& script_path : スクリプトのパス
+         * vector<string>& images : 出力する画像(.png)のパス
+         *                          1つの場合は全設計結果を重ねて描画し，
+         *                          設計結果の数と同じ場合は1つずつ描画する
+         * ExportColumn col : 描画する特性
+         */
+        void ResponseExporter::write_gnuplot(
+            const std::string& data_path,
+            const std::string& script_path,
+            const std::vector< std::string >& images,
+            ExportColumn col ) const
+        {
+            if ( images.size() != 1 && images.size() != names.size() )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Number of images is illegal.(images : %llu, "
+                    "designs : %llu)\n",
+                    __FILE__, __LINE__,
+                    static_cast< unsigned long long >( images.size() ),
+                    static_cast< unsigned long long >( names.size() ) );
+                exit( EXIT_FAILURE );
+            }
+            write_text( data_path, ' ', false );
+
+            static const char* const ylabel[ncolumn] = {
+                "Amplitude", "Magnitude[dB]", "Phase[rad]", "Group delay[sample]"
+            };
+            const std::size_t icol = static_cast< std::size_t >( col );
+
+            FILE* gp = fileopen( script_path, 'w', __FILE__, __LINE__ );
+            fprintf( gp, "set terminal pngcairo size 1280, 960\n" );
+            fprintf( gp, "set grid\n" );
+            fprintf(
+                gp,
+                "set xlabel 'Normalized angular frequency'\n" );    //正規化角周波数
+            fprintf( gp, "set ylabel '%s'\n", ylabel[icol] );
+            fprintf( gp, "set key    font 'Times New Roman,15'\n" );
+            fprintf( gp, "set xlabel font 'Times New Roman,20'\n" );
+            fprintf( gp, "set ylabel font 'Times New Roman,20'\n" );
+            fprintf( gp, "set tics   font 'Times New Roman,15'\n" );
+            if ( !freq.empty() )
+            {
+                fprintf(
+                    gp, "set xrange [%f:%f]\n", freq.front() * 2.0 * M_PI,
+                    freq.back() * 2.0 * M_PI );
+            }
+            fprintf( gp, "set xtics 0, 0.1*pi, pi\n" );
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat"
+            fprintf( gp, "set format x '%.1Pπ'\n" );
+#pragma GCC diagnostic pop
+            fprintf( gp, "set lmargin 20\n" );
+            fprintf( gp, "set bmargin 10\n" );
+
+            for ( std::size_t d = 0; d < names.size(); ++d )
+            {
+                const std::size_t ycol = 2 + d * ncolumn + icol;    // 1始まりの列番号
+                const bool first = images.size() == 1 ? d == 0 : true;
+                const bool last = images.size() == 1 ? d + 1 == names.size() : true;
+                if ( first )
+                {
+                    fprintf(
+                        gp, "set output %s\n",
+                        gnuplot_quote( images[images.size() == 1 ? 0 : d] ).c_str() );
+                    fprintf( gp, "plot " );
+                }
+                else
+                {
+                    fprintf( gp, ", \\\n     " );
+                }
+                fprintf(
+                    gp, "%s using (2*pi*$1):%llu with lines title %s",
+                    gnuplot_quote( data_path ).c_str(), static_cast< unsigned long long >( ycol ),
+                    gnuplot_quote( names.size() == 1 ? std::string() : names[d] ).c_str() );
+                if ( last )
+                {
+                    fprintf( gp, "\n" );
+                }
+            }
+            fclose( gp );
+        }
+
+        /* # 周波数特性の書き出し
+         *   データとスクリプトを一時ファイルに書き出してgnuplotで描画し，
+         *   一時ファイルは描画後に削除する(画像のみ残る)
+         *   一時ファイルはTMPDIR(未設定の場合は/tmp)に作成する
+         *
+         * # 引数
+         * vector<string>& images : 出力する画像(.png)のパス(write_gnuplotと同様)
+         * ExportColumn col : 描画する特性
+         * # 返り値
+         * bool rendered : 描画した場合true
+         */
+        bool ResponseExporter::plot(
+            const std::vector< std::string >& images, ExportColumn col ) const
+        {
+            const char* tmpdir = std::getenv( "TMPDIR" );
+            std::string base = tmpdir != nullptr && *tmpdir != '\0' ? tmpdir : "/tmp";
+            base += "/filter_param_XXXXXX";
+            const int fd = mkstemp( &base[0] );
+            if ( fd < 0 )
+            {
+                fprintf(
+                    stderr, "Error: [%s l.%d]Can't create temporary file.(template : %s)\n",
+                    __FILE__, __LINE__, base.c_str() );
+                exit( EXIT_FAILURE );
+            }
+            close( fd );
+
+            // mkstempで確保した名前に拡張子を付け，他のプロセスと衝突しないようにする
+            const std::string data_path = base + ".dat";
+            const std::string script_path = base + ".gp";
+            write_gnuplot( data_path, script_path, images, col );
+            const bool rendered = render_gnuplot( script_path );
+            std::remove( data_path.c_str() );
+            std::remove( script_path.c_str() );
+            std::remove( base.c_str() );
+            return rendered;
+        }
+
+    }    // namespace iir
+}    // namespace filter
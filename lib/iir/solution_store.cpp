@@ -0,0 +1,371 @@
+/*
+ * solution_store.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#include "solution_store.hpp"
+
+#include "cascade_iir.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <random>
+#include <sys/file.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+
+namespace filter
+{
+    FILE* fileopen( const std::string&, const char, const std::string&, const int );
+
+    namespace iir
+    {
+        namespace
+        {
+            const char store_magic[8] = { 'F', 'P', 'S', 'O', 'L', 'S', '0', '1' };
+            constexpr std::size_t record_header_bytes =
+                4 * sizeof( std::uint32_t ) + 2 * sizeof( double );
+            constexpr std::size_t band_bytes = sizeof( std::uint64_t ) + 2 * sizeof( double );
+        }    // namespace
+
+        /* # 解の保存庫
+         *   ファイルを開いて索引を作る(存在しない場合はヘッダのみのファイルを作る)
+         *
+         * # 引数
+         * string& input_path : ファイルのパス
+         * double input_gd_scale : 仕様の距離における群遅延の差の重み
+         */
+        SolutionStore::SolutionStore( const std::string& input_path, double input_gd_scale )
+            : path( input_path ), gd_scale( input_gd_scale ), valid_bytes( header_bytes )
+        {
+            FILE* probe = fopen( path.c_str(), "rb" );
+            if ( probe == nullptr )
+            {
+                FILE* fp = fileopen( path, 'w', __FILE__, __LINE__ );
+                fwrite( store_magic, 1, sizeof( store_magic ), fp );
+                fclose( fp );
+            }
+            else
+            {
+                fclose( probe );
+            }
+            reload();
+        }
+
+        SolutionStore::~SolutionStore() = default;
+
+        /* # 解の保存庫
+         *   ファイルをマップし直す(索引は変えない)
+         */
+        void SolutionStore::remap()
+        {
+            file.reset();
+            file.reset( new MappedFile( path ) );
+            if ( file->size() < header_bytes
+                 || std::memcmp( file->data(), store_magic, sizeof( store_magic ) ) != 0 )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Format of solution store is illegal.(file name : %s)\n",
+                    __FILE__, __LINE__, path.c_str() );
+                exit( EXIT_FAILURE );
+            }
+        }
+
+        /* # 解の保存庫
+         *   ファイル内の位置posから末尾までの記録を索引に加える
+         *   書き込みの途中で終わった記録があればその手前で止め，valid_bytesを完全な記録の終端とする
+         *
+         * # 引数
+         * size_t pos : 記録の先頭の位置 [byte]
+         */
+        void SolutionStore::index_records( std::size_t pos )
+        {
+            const char* data = file->data();
+            while ( pos + record_header_bytes <= file->size() )
+            {
+                std::uint32_t order[4];
+                std::memcpy( order, data + pos, sizeof( order ) );
+                Entry entry;
+                entry.n_order = order[0];
+                entry.m_order = order[1];
+                entry.nband = order[2];
+                std::memcpy( &entry.gd, data + pos + sizeof( order ), sizeof( double ) );
+                std::memcpy(
+                    &entry.value, data + pos + sizeof( order ) + sizeof( double ),
+                    sizeof( double ) );
+                entry.offset = pos + record_header_bytes;
+
+                const std::size_t ncoef = 1 + std::size_t( entry.n_order ) + entry.m_order;
+                const std::size_t size =
+                    record_header_bytes + entry.nband * band_bytes + ncoef * sizeof( double );
+                if ( pos + size > file->size() )
+                {
+                    break;    // 書き込みの途中で終わった記録
+                }
+                entries.emplace_back( entry );
+                pos += size;
+            }
+            valid_bytes = pos;
+        }
+
+        /* # 解の保存庫
+         *   ファイルをマップし直し，記録の索引を作り直す
+         */
+        void SolutionStore::reload()
+        {
+            remap();
+            entries.clear();
+            index_records( header_bytes );
+        }
+
+        const double* SolutionStore::band_data( const Entry& entry ) const
+        {
+            return reinterpret_cast< const double* >( file->data() + entry.offset );
+        }
+
+        const double* SolutionStore::coef_data( const Entry& entry ) const
+        {
+            return reinterpret_cast< const double* >(
+                file->data() + entry.offset + entry.nband * band_bytes );
+        }
+
+        /* # 解の保存庫
+         *   解を仕様と組にしてファイルに追記する
+         *
+         * # 引数
+         * FilterParam& param : 解を求めた仕様
+         * vector<double>& coef : 係数列
+         * double value : 目的関数値
+         */
+        void SolutionStore::add(
+            const FilterParam& param, const std::vector< double >& coef, double value )
+        {
+            if ( coef.size() != param.opt_order() )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Size of coefficients is illegal.(size : %llu, "
+                    "expected : %u)\n",
+                    __FILE__, __LINE__, static_cast< unsigned long long >( coef.size() ),
+                    param.opt_order() );
+                exit( EXIT_FAILURE );
+            }
+
+            const std::vector< BandParam > bands = param.fbands();
+            const std::uint32_t order[4] = { param.zero_order(), param.pole_order(),
+                                             static_cast< std::uint32_t >( bands.size() ), 0 };
+            const double gd = param.gd();
+
+            // 記録を1つの領域に並べ，1回のwriteで追記する
+            std::vector< char > record;
+            auto append = [&]( const void* src, std::size_t bytes )
+            {
+                const char* begin = static_cast< const char* >( src );
+                record.insert( record.end(), begin, begin + bytes );
+            };
+            append( order, sizeof( order ) );
+            append( &gd, sizeof( double ) );
+            append( &value, sizeof( double ) );
+            for ( const auto& band : bands )
+            {
+                const std::uint64_t type = static_cast< std::uint64_t >( band.type() );
+                const double edge[2] = { band.left(), band.right() };
+                append( &type, sizeof( std::uint64_t ) );
+                append( edge, sizeof( edge ) );
+            }
+            append( coef.data(), coef.size() * sizeof( double ) );
+
+            const int fd = open( path.c_str(), O_WRONLY | O_APPEND );
+            if ( fd < 0 || flock( fd, LOCK_EX ) != 0 )
+            {
+                fprintf(
+                    stderr, "Error: [%s l.%d]Failed to lock solution store.(file name : %s)\n",
+                    __FILE__, __LINE__, path.c_str() );
+                exit( EXIT_FAILURE );
+            }
+
+            // 他のプロセスが追記した記録を排他の下で読み直してから末尾を判定する
+            // (追記は常に排他の下で行うため，ここで残る途中の記録は異常終了した書き込みのみ)
+            remap();
+            index_records( valid_bytes );
+
+            // 途中で終わった末尾の記録の後ろに追記すると以降の記録の位置がずれるため，
+            // 最後の完全な記録の終端まで切り詰めてから追記する
+            bool failed = file->size() > valid_bytes
+                          && ftruncate( fd, static_cast< off_t >( valid_bytes ) ) != 0;
+            std::size_t written = 0;
+            while ( !failed && written < record.size() )
+            {
+                const ssize_t n = write( fd, record.data() + written, record.size() - written );
+                failed = n < 0;
+                written += failed ? 0 : static_cast< std::size_t >( n );
+            }
+            flock( fd, LOCK_UN );
+            close( fd );
+            if ( failed )
+            {
+                fprintf(
+                    stderr, "Error: [%s l.%d]Failed to write solution store.(file name : %s)\n",
+                    __FILE__, __LINE__, path.c_str() );
+                exit( EXIT_FAILURE );
+            }
+
+            // 既存の記録は変わらないため，追記した記録のみを索引に加える
+            remap();
+            index_records( valid_bytes );
+        }
+
+        /* # 解の保存庫
+         *   仕様とindex番目の記録の仕様の距離
+         *   零点・極の数または帯域の種類の並びが異なる場合は無限大とする
+         */
+        double SolutionStore::distance( const FilterParam& param, std::size_t index ) const
+        {
+            const Entry& entry = entries.at( index );
+            const std::vector< BandParam > bands = param.fbands();
+            if ( entry.n_order != param.zero_order() || entry.m_order != param.pole_order()
+                 || entry.nband != bands.size() )
+            {
+                return std::numeric_limits< double >::infinity();
+            }
+
+            const double* band = band_data( entry );
+            double dist = gd_scale * std::abs( entry.gd - param.gd() );
+            for ( unsigned int i = 0; i < bands.size(); ++i, band += 3 )
+            {
+                std::uint64_t type = 0;
+                std::memcpy( &type, band, sizeof( type ) );
+                if ( type != static_cast< std::uint64_t >( bands[i].type() ) )
+                {
+                    return std::numeric_limits< double >::infinity();
+                }
+                dist += std::abs( band[1] - bands[i].left() )
+                        + std::abs( band[2] - bands[i].right() );
+            }
+            return dist;
+        }
+
+        /* # 解の保存庫
+         *   仕様に近い順(同じ距離は保存時の目的関数値の小さい順)に解を取り出す
+         *
+         * # 引数
+         * FilterParam& param : 新しい仕様
+         * size_t count : 取り出す最大数
+         * # 返り値
+         * vector<StoredSolution> solutions : 近い順の解(候補となる記録が少なければcount未満)
+         */
+        std::vector< StoredSolution >
+        SolutionStore::nearest( const FilterParam& param, std::size_t count ) const
+        {
+            std::vector< std::pair< double, std::size_t > > order;
+            for ( std::size_t k = 0; k < entries.size(); ++k )
+            {
+                const double dist = distance( param, k );
+                if ( dist < std::numeric_limits< double >::infinity() )
+                {
+                    order.emplace_back( dist, k );
+                }
+            }
+            const std::size_t n = std::min( count, order.size() );
+            std::partial_sort(
+                order.begin(), order.begin() + static_cast< std::ptrdiff_t >( n ), order.end(),
+                [&]( const std::pair< double, std::size_t >& x,
+                     const std::pair< double, std::size_t >& y )
+                {
+                    if ( x.first < y.first || y.first < x.first )
+                    {
+                        return x.first < y.first;
+                    }
+                    return entries[x.second].value < entries[y.second].value;
+                } );
+
+            std::vector< StoredSolution > solutions( n );
+            for ( std::size_t k = 0; k < n; ++k )
+            {
+                const Entry& entry = entries[order[k].second];
+                const double* coef = coef_data( entry );
+                solutions[k].distance = order[k].first;
+                solutions[k].value = entry.value;
+                solutions[k].coef.assign( coef, coef + param.opt_order() );
+            }
+            return solutions;
+        }
+
+        /* # 解の保存庫
+         *   新しい仕様の初期集団を作る
+         *   近い仕様の解をsize個まで取り出して新しい仕様で評価し直し，良い順に並べる
+         *   残りは良い順に巡回して各係数に相対的な正規乱数(標準偏差jitter)を掛けた複製とし，
+         *   候補となる解が無い場合はinit_stable_coef(a0, a)で埋める
+         *
+         * # 引数
+         * FilterParam& param : 新しい仕様
+         * size_t size : 集団の大きさ
+         * double jitter : 複製に加える摂動の相対的な大きさ
+         * double a0, a : 候補が無い場合の初期値の範囲(init_stable_coefの引数)
+         * # 返り値
+         * vector<vector<double>> population : 初期集団
+         */
+        std::vector< std::vector< double > > SolutionStore::seed_population(
+            const FilterParam& param,
+            std::size_t size,
+            double jitter,
+            double a0,
+            double a ) const
+        {
+            std::vector< std::vector< double > > population;
+            population.reserve( size );
+
+            const std::vector< StoredSolution > solutions = nearest( param, size );
+            if ( solutions.empty() )
+            {
+                for ( std::size_t k = 0; k < size; ++k )
+                {
+                    population.emplace_back( param.init_stable_coef( a0, a ) );
+                }
+                return population;
+            }
+
+            std::vector< std::vector< double > > seeds;
+            for ( const auto& solution : solutions )
+            {
+                seeds.emplace_back( solution.coef );
+            }
+            const std::vector< double > values = param.evaluate_batch( seeds );
+            std::vector< std::size_t > rank( seeds.size() );
+            for ( std::size_t k = 0; k < rank.size(); ++k )
+            {
+                rank[k] = k;
+            }
+            std::stable_sort(
+                rank.begin(), rank.end(),
+                [&]( std::size_t x, std::size_t y ) { return values[x] < values[y]; } );
+
+            thread_local std::random_device rnd;
+            thread_local std::mt19937 mt( rnd() );
+            std::normal_distribution<> noise( 0.0, jitter );
+            for ( std::size_t k = 0; k < size; ++k )
+            {
+                population.emplace_back( seeds[rank[k % rank.size()]] );
+                if ( k >= rank.size() )
+                {
+                    for ( auto& c : population.back() )
+                    {
+                        c *= 1.0 + noise( mt );
+                    }
+                }
+            }
+            return population;
+        }
+
+    }    // namespace iir
+}    // namespace filter
@@ -0,0 +1,253 @@
+/*
+ * surrogate.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ */
+
+#include "surrogate.hpp"
+
+#include "cascade_iir.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+
+
+namespace filter
+{
+    namespace iir
+    {
+        ScreenResult::ScreenResult() = default;
+        ScreenResult::ScreenResult( const ScreenResult& ) = default;
+        ScreenResult::ScreenResult( ScreenResult&& ) noexcept = default;
+        ScreenResult& ScreenResult::operator=( const ScreenResult& ) = default;
+        ScreenResult& ScreenResult::operator=( ScreenResult&& ) noexcept = default;
+        ScreenResult::~ScreenResult() = default;
+
+        /* # 代理モデルによる選別
+         *
+         * # 引数
+         * SurrogateConfig& input_config : 設定
+         */
+        SurrogateScreen::SurrogateScreen( const SurrogateConfig& input_config )
+            : config( input_config ), dimension( 0 ), next( 0 )
+        {
+            if ( config.capacity == 0 || config.neighbors == 0
+                 || !( config.fraction > 0.0 && config.fraction <= 1.0 ) )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Surrogate config is illegal.(capacity : %llu, neighbors "
+                    ": %u, fraction : %f)\n",
+                    __FILE__, __LINE__, static_cast< unsigned long long >( config.capacity ),
+                    config.neighbors, config.fraction );
+                exit( EXIT_FAILURE );
+            }
+        }
+
+        SurrogateScreen::~SurrogateScreen() = default;
+
+        // 本評価の残りの回数(上限が無い場合はsize_tの最大値)
+        std::size_t SurrogateScreen::remaining_budget() const
+        {
+            if ( config.eval_budget == 0 )
+            {
+                return std::numeric_limits< std::size_t >::max();
+            }
+            return config.eval_budget > stats.nevaluated ? config.eval_budget - stats.nevaluated
+                                                         : 0;
+        }
+
+        /* # 代理モデルによる選別
+         *   (係数列, 目的関数値)の組を加える(容量を超えた場合は最も古い組を置き換える)
+         */
+        void SurrogateScreen::add( const std::vector< double >& coef, double value )
+        {
+            if ( dimension == 0 )
+            {
+                dimension = coef.size();
+            }
+            if ( coef.size() != dimension )
+            {
+                fprintf(
+                    stderr,
+                    "Error: [%s l.%d]Size of coefficients is illegal.(size : %llu, "
+                    "expected : %llu)\n",
+                    __FILE__, __LINE__, static_cast< unsigned long long >( coef.size() ),
+                    static_cast< unsigned long long >( dimension ) );
+                exit( EXIT_FAILURE );
+            }
+
+            if ( archive_value.size() < config.capacity )
+            {
+                archive_coef.insert( archive_coef.end(), coef.begin(), coef.end() );
+                archive_value.emplace_back( value );
+                return;
+            }
+            std::copy(
+                coef.begin(), coef.end(),
+                archive_coef.begin() + static_cast< std::ptrdiff_t >( next * dimension ) );
+            archive_value[next] = value;
+            next = ( next + 1 ) % config.capacity;
+        }
+
+        /* # 代理モデルによる選別
+         *   k近傍の逆距離加重平均で目的関数値を予測する
+         *   保持した組と一致する係数列はその値を返し，組が無い場合は無限大とする
+         *
+         * # 引数
+         * vector<double>& coef : 係数列
+         * # 返り値
+         * double value : 目的関数値の予測値
+         */
+        double SurrogateScreen::predict( const std::vector< double >& coef ) const
+        {
+            const std::size_t narchive = archive_value.size();
+            if ( narchive == 0 )
+            {
+                return std::numeric_limits< double >::infinity();
+            }
+
+            std::vector< std::pair< double, std::size_t > > dist( narchive );
+            for ( std::size_t k = 0; k < narchive; ++k )
+            {
+                const double* c = archive_coef.data() + k * dimension;
+                double d2 = 0.0;
+                for ( std::size_t i = 0; i < dimension; ++i )
+                {
+                    const double diff = coef[i] - c[i];
+                    d2 += diff * diff;
+                }
+                dist[k] = std::make_pair( d2, k );
+            }
+            const std::size_t nneighbor = std::min< std::size_t >( config.neighbors, narchive );
+            std::partial_sort(
+                dist.begin(), dist.begin() + static_cast< std::ptrdiff_t >( nneighbor ),
+                dist.end() );
+
+            if ( !( dist[0].first > 0.0 ) )
+            {
+                return archive_value[dist[0].second];
+            }
+            double sum = 0.0;
+            double weight_sum = 0.0;
+            for ( std::size_t k = 0; k < nneighbor; ++k )
+            {
+                const double weight = 1.0 / dist[k].first;
+                sum += weight * archive_value[dist[k].second];
+                weight_sum += weight;
+            }
+            return sum / weight_sum;
+        }
+
+        /* # 代理モデルによる選別
+         *   1世代の候補を予測値で順位付けし，良い方からfractionの割合(本評価の残りの回数まで)
+         *   を本評価する
+         *   さらに選ばれなかった候補から無作為にauditの数(残りの回数まで)を本評価する
+         *   保持した組がmin_archive未満の間は，先頭から残りの回数まで本評価する
+         *   本評価した候補は組に加え，予測値を持つものは統計を更新する
+         *
+         * # 引数
+         * FilterParam& param : 本評価に用いるフィルタ構造体
+         * vector<vector<double>>& trials : 候補の係数列
+         * # 返り値
+         * ScreenResult result : 目的関数値(本評価または予測値)と本評価したかどうか
+         */
+        ScreenResult SurrogateScreen::screen(
+            const FilterParam& param, const std::vector< std::vector< double > >& trials )
+        {
+            const std::size_t ntrial = trials.size();
+            ScreenResult result;
+            result.value.assign( ntrial, std::numeric_limits< double >::infinity() );
+            result.evaluated.assign( ntrial, false );
+
+            const bool warm = archive_value.size() >= config.min_archive;
+            std::vector< std::size_t > order( ntrial );
+            for ( std::size_t k = 0; k < ntrial; ++k )
+            {
+                order[k] = k;
+            }
+            const std::size_t budget = remaining_budget();
+            std::size_t count = std::min( ntrial, budget );
+            std::size_t naudit = 0;
+            if ( warm )
+            {
+                for ( std::size_t k = 0; k < ntrial; ++k )
+                {
+                    result.value[k] = predict( trials[k] );
+                }
+                std::stable_sort(
+                    order.begin(), order.end(),
+                    [&]( std::size_t x, std::size_t y )
+                    { return result.value[x] < result.value[y]; } );
+                const std::size_t promising = std::max< std::size_t >(
+                    1, static_cast< std::size_t >(
+                           std::ceil( config.fraction * static_cast< double >( ntrial ) ) ) );
+                count = std::min( count, promising );
+
+                // 選ばれなかった候補の一部を無作為に選んで後ろに並べる(部分的なシャッフル)
+                naudit = std::min( config.audit, std::min( ntrial, budget ) - count );
+                for ( std::size_t k = count; k < count + naudit; ++k )
+                {
+                    std::uniform_int_distribution< std::size_t > pick( k, ntrial - 1 );
+                    std::swap( order[k], order[pick( rng )] );
+                }
+            }
+            const std::size_t nexact = count + naudit;
+
+            std::vector< std::vector< double > > selected;
+            selected.reserve( nexact );
+            for ( std::size_t k = 0; k < nexact; ++k )
+            {
+                selected.emplace_back( trials[order[k]] );
+            }
+            const std::vector< double > values = param.evaluate_batch( selected );
+
+            if ( warm )
+            {
+                for ( std::size_t a = 0; a < nexact; ++a )
+                {
+                    const double predicted = result.value[order[a]];
+                    const double scale = std::max( std::abs( values[a] ), 1.0e-300 );
+                    stats.relative_error += std::abs( predicted - values[a] ) / scale;
+                    ++stats.nchecked;
+                    for ( std::size_t b = a + 1; b < nexact; ++b )
+                    {
+                        const bool predicted_less = predicted < result.value[order[b]];
+                        const bool actual_less = values[a] < values[b];
+                        ++stats.npair;
+                        if ( predicted_less == actual_less )
+                        {
+                            ++stats.nconcordant;
+                        }
+                    }
+                }
+            }
+            else if ( count < ntrial )
+            {
+                // 予測できる組が無い間に本評価の回数が尽きた候補は予測値とする
+                for ( std::size_t k = count; k < ntrial; ++k )
+                {
+                    result.value[k] = predict( trials[k] );
+                }
+            }
+
+            for ( std::size_t a = 0; a < nexact; ++a )
+            {
+                result.value[order[a]] = values[a];
+                result.evaluated[order[a]] = true;
+                add( selected[a], values[a] );
+            }
+            stats.ncandidate += ntrial;
+            stats.nevaluated += nexact;
+            stats.npredicted += ntrial - nexact;
+            stats.naudited += naudit;
+            return result;
+        }
+
+    }    // namespace iir
+}    // namespace filter
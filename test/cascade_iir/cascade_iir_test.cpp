@@ -6,11 +6,20 @@
  */
 
 #include "cascade_iir.hpp"
+#include "multi_spec.hpp"
 
 #include <assert.h>
 #include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
 #include <string>
+#include <sys/stat.h>
+#include <unistd.h>
 
 
 using namespace std;
@@ -44,6 +53,31 @@ void test_FilterParam_pole_even();
 void test_FilterParam_pole_odd();
 void test_FilterParam_zero_even();
 void test_FilterParam_zero_odd();
+void test_FilterParam_pole_batch();
+void test_FilterParam_section_cache();
+void test_FilterParam_result_cache();
+void test_FilterParam_evaluate_batch();
+void test_FilterParam_parallel_sweep();
+void test_sweep_response();
+void test_ResponseExporter();
+void test_FilterParam_response_engine();
+void test_FilterParam_fft_response();
+void test_FilterParam_gen_tables();
+void test_FilterParam_copy();
+void test_FilterParam_parity_dispatch();
+void test_FilterParam_coef_size_check();
+void test_FilterParam_squared_error();
+void test_FilterParam_objective_config();
+void test_FilterParam_desire_spec();
+void test_BiquadCascade_impulse();
+void test_filter_file();
+void test_FilterParam_quantized();
+void test_FilterParam_pole_param();
+void test_FilterParam_riple_bound();
+void test_FilterParam_retarget();
+void test_MultiSpecEvaluator();
+void test_SolutionStore();
+void test_SurrogateScreen();
 
 int main( int argc, char** argv )
 {
@@ -142,6 +176,106 @@ int main( int argc, char** argv )
     {
         test_FilterParam_gprint_mag();
     }
+    else if ( args.at( 1 ) == string( "FilterParam_pole_batch" ) )
+    {
+        test_FilterParam_pole_batch();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_section_cache" ) )
+    {
+        test_FilterParam_section_cache();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_result_cache" ) )
+    {
+        test_FilterParam_result_cache();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_evaluate_batch" ) )
+    {
+        test_FilterParam_evaluate_batch();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_parallel_sweep" ) )
+    {
+        test_FilterParam_parallel_sweep();
+    }
+    else if ( args.at( 1 ) == string( "sweep_response" ) )
+    {
+        test_sweep_response();
+    }
+    else if ( args.at( 1 ) == string( "ResponseExporter" ) )
+    {
+        test_ResponseExporter();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_response_engine" ) )
+    {
+        test_FilterParam_response_engine();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_fft_response" ) )
+    {
+        test_FilterParam_fft_response();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_gen_tables" ) )
+    {
+        test_FilterParam_gen_tables();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_copy" ) )
+    {
+        test_FilterParam_copy();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_parity_dispatch" ) )
+    {
+        test_FilterParam_parity_dispatch();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_coef_size_check" ) )
+    {
+        test_FilterParam_coef_size_check();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_squared_error" ) )
+    {
+        test_FilterParam_squared_error();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_objective_config" ) )
+    {
+        test_FilterParam_objective_config();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_desire_spec" ) )
+    {
+        test_FilterParam_desire_spec();
+    }
+    else if ( args.at( 1 ) == string( "BiquadCascade_impulse" ) )
+    {
+        test_BiquadCascade_impulse();
+    }
+    else if ( args.at( 1 ) == string( "filter_file" ) )
+    {
+        test_filter_file();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_quantized" ) )
+    {
+        test_FilterParam_quantized();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_pole_param" ) )
+    {
+        test_FilterParam_pole_param();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_riple_bound" ) )
+    {
+        test_FilterParam_riple_bound();
+    }
+    else if ( args.at( 1 ) == string( "FilterParam_retarget" ) )
+    {
+        test_FilterParam_retarget();
+    }
+    else if ( args.at( 1 ) == string( "MultiSpecEvaluator" ) )
+    {
+        test_MultiSpecEvaluator();
+    }
+    else if ( args.at( 1 ) == string( "SolutionStore" ) )
+    {
+        test_SolutionStore();
+    }
+    else if ( args.at( 1 ) == string( "SurrogateScreen" ) )
+    {
+        test_SurrogateScreen();
+    }
     else
     {
         fprintf( stderr, "Matching test is not exist.\n" );
@@ -688,6 +822,13 @@ void test_FilterParam_evaluate_objective_function()
     auto objective_function_value = fparam.evaluate( coef );
 
     printf( "objective_function_value %f\n", objective_function_value );
+
+    // 振幅の2乗で比較する評価が，std::absで求めた値と丸め誤差の範囲で一致すること
+    const double expect = 0.026067336010904742;
+    assert( std::abs( objective_function_value - expect ) <= 1.0e-12 * expect );
+    (void)expect;
+
+    assert( double_bits( fparam.evaluate_batch( vector< vector< double > > { coef } ).at( 0 ) ) == double_bits( objective_function_value ) );
 }
 
 void test_FilterParam_init_coef()
@@ -1105,3 +1246,2148 @@ void test_FilterParam_zero_odd()
         assert( static_cast< size_t >( std::round( zero_res.at( m ).imag() * acc2 ) ) == static_cast< size_t >( std::round( test_zero.at( m ).imag() * acc2 ) ) );
     }
 }
+
+/* フィルタ構造体
+ * 極・零点の一括計算が，個別の計算結果と一致することを確認する
+ * 重解を含まない係数列で比較し，最大極半径も検査する
+ *
+ */
+void test_FilterParam_pole_batch()
+{
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 );
+    FilterParam fparam( 7, 4, bands, 200, 50, 5.0 );
+
+    vector< vector< double > > coefs {
+        { 0.025247504683641238, 0.8885952985540255, -4.097963802039866,
+          5.496940685423355, 0.3983519261092186, 0.9723236917140877,
+          1.1168784833810899, 0.8492039597182939, -0.686114259307724,
+          0.22008381076439384, -0.22066728558327908, 0.7668032045079851 },
+        { 0.025247504683641238, 0.8885952985540255, -4.097963802039866,
+          5.496940685423355, -1.585891794, -1.903482473, 1.1168784833810899,
+          0.8492039597182939, 2.686114259307724, 1.22008381076439384,
+          -0.22066728558327908, 0.7668032045079851 }
+    };
+
+    RootBuffer poles;
+    RootBuffer zeros;
+    fparam.pole_batch( coefs, poles, true );
+    fparam.zero_batch( coefs, zeros );
+
+    assert( poles.count == coefs.size() && poles.order == 4 );
+    assert( zeros.count == coefs.size() && zeros.order == 7 );
+    assert( poles.radius.size() == coefs.size() && zeros.radius.empty() );
+
+    const double acc = 1.0e-12;
+    for ( std::size_t c = 0; c < coefs.size(); ++c )
+    {
+        auto pole_res = fparam.pole_res( coefs.at( c ) );
+        auto zero_res = fparam.zero_res( coefs.at( c ) );
+        assert( pole_res.size() == poles.order );
+        assert( zero_res.size() == zeros.order );
+
+        double max_radius = 0.0;
+        for ( unsigned int k = 0; k < poles.order; ++k )
+        {
+            printf(
+                "pole[%llu][%u] %.15f %.15f\n",
+                static_cast< unsigned long long >( c ), k,
+                poles.root( c, k ).real(), poles.root( c, k ).imag() );
+            assert( abs( poles.root( c, k ) - pole_res.at( k ) ) < acc );
+            max_radius = std::max( max_radius, abs( pole_res.at( k ) ) );
+        }
+        for ( unsigned int k = 0; k < zeros.order; ++k )
+        {
+            assert( abs( zeros.root( c, k ) - zero_res.at( k ) ) < acc );
+        }
+
+        printf(
+            "max pole radius[%llu] %.15f\n",
+            static_cast< unsigned long long >( c ), poles.radius.at( c ) );
+        assert( std::abs( poles.radius.at( c ) - max_radius ) < acc );
+    }
+    assert( poles.radius.at( 0 ) < 1.0 );
+    assert( poles.radius.at( 1 ) > 1.0 );
+    (void)acc;
+}
+
+/* フィルタ構造体
+ * セクション応答のキャッシュを用いた周波数特性が，
+ * キャッシュを用いない場合と一致することを確認する
+ * また，同じセクションを持つ個体の評価でキャッシュがヒットすることを確認する
+ *
+ */
+void test_FilterParam_section_cache()
+{
+    vector< double > coef { -0.040659737, -2.372311969,
+
+                            -2.144646171, 4.343497453, 1.359348897,
+                            0.984834163,
+
+                            -0.710147059, -0.696696684, 0.514853197,
+                            0.503697311, 0.70680348 };
+
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.3, 0.345 );
+    FilterParam fparam( 5, 5, bands, 200, 50, 5.0 );
+    FilterParam cached( 5, 5, bands, 200, 50, 5.0 );
+    cached.enable_section_cache( 64 );
+
+    auto expect = fparam.freq_res( coef );
+    auto actual = cached.freq_res( coef );
+    for ( unsigned int i = 0; i < expect.size(); ++i )
+    {
+        assert( expect.at( i ).size() == actual.at( i ).size() );
+        for ( unsigned int j = 0; j < expect.at( i ).size(); ++j )
+        {
+            assert(
+                abs( expect.at( i ).at( j ) - actual.at( i ).at( j ) )
+                <= 1.0e-12 * ( 1.0 + abs( expect.at( i ).at( j ) ) ) );
+        }
+    }
+
+    // 1次セクション + 2次セクション2つ(分子・分母)の6セクション
+    auto stats = cached.section_cache_stats();
+    printf(
+        "first : hits %llu, misses %llu\n",
+        static_cast< unsigned long long >( stats.hits ),
+        static_cast< unsigned long long >( stats.misses ) );
+    assert( stats.hits == 0 && stats.misses == 6 && stats.entries == 6 );
+
+    // 分母の2次セクションだけ変えた個体は，1セクションのみ計算する
+    auto child = coef;
+    child.at( 9 ) = 0.4;
+    double expect_value = fparam.evaluate( child );
+    double actual_value = cached.evaluate( child );
+    printf( "evaluate : %.15f %.15f\n", expect_value, actual_value );
+    assert( std::abs( expect_value - actual_value ) <= 1.0e-12 * expect_value );
+
+    stats = cached.section_cache_stats();
+    printf(
+        "second : hits %llu, misses %llu, rate %f\n",
+        static_cast< unsigned long long >( stats.hits ),
+        static_cast< unsigned long long >( stats.misses ), stats.hit_rate() );
+    assert( stats.hits == 5 && stats.misses == 7 );
+
+    cached.clear_section_cache();
+    assert( cached.section_cache_stats().entries == 0 );
+}
+
+/* フィルタ構造体
+ * 評価値のキャッシュが同一の係数列でヒットし，
+ * 異なる係数列や閾値変更後には再計算されることを確認する
+ *
+ */
+void test_FilterParam_result_cache()
+{
+    vector< double > coef { 0.025247504683641238,
+
+                            0.8885952985540255, -4.097963802039866,
+                            5.496940685423355, 0.3983519261092186,
+                            0.9723236917140877, 1.1168784833810899,
+                            0.8492039597182939,
+
+                            -0.686114259307724, 0.22008381076439384,
+                            -0.22066728558327908, 0.7668032045079851 };
+
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 );
+    FilterParam fparam( 7, 4, bands, 200, 50, 5.0 );
+    const double expect = fparam.evaluate( coef );
+
+    fparam.enable_result_cache( 32 );
+    for ( unsigned int i = 0; i < 4; ++i )
+    {
+        assert( double_bits( fparam.evaluate( coef ) ) == double_bits( expect ) );
+    }
+    (void)expect;
+    auto stats = fparam.result_cache_stats();
+    printf(
+        "hits %llu, misses %llu, rate %f\n",
+        static_cast< unsigned long long >( stats.hits ),
+        static_cast< unsigned long long >( stats.misses ), stats.hit_rate() );
+    assert( stats.hits == 3 && stats.misses == 1 && stats.entries == 1 );
+
+    // 1ビットでも異なる係数列は別の候補
+    auto other = coef;
+    other.at( 0 ) = std::nextafter( other.at( 0 ), 1.0 );
+    fparam.evaluate( other );
+    assert( fparam.result_cache_stats().misses == 2 );
+
+    // 閾値を変えるとキャッシュは作り直される
+    fparam.set_threshold_riple( 0.5 );
+    FilterParam reference( 7, 4, bands, 200, 50, 5.0 );
+    reference.set_threshold_riple( 0.5 );
+    assert( fparam.result_cache_stats().entries == 0 );
+    assert(
+        double_bits( fparam.evaluate( coef ) )
+        == double_bits( reference.evaluate( coef ) ) );
+
+    // 容量はシャード数より小さくても超えない
+    for ( const std::size_t capacity : { std::size_t( 1 ), std::size_t( 3 ), std::size_t( 20 ) } )
+    {
+        ResultCache cache( capacity );
+        for ( unsigned int i = 0; i < 64; ++i )
+        {
+            auto trial = coef;
+            trial.at( 0 ) += 1.0e-3 * i;
+            cache.insert( trial, static_cast< double >( i ) );
+            assert( cache.stats().entries <= capacity );
+        }
+        assert( cache.stats().entries + cache.stats().evictions == 64 );
+    }
+}
+
+/* フィルタ構造体
+ * タイル分割した一括評価が，個別のevaluateと一致することを確認する
+ * タイル寸法を小さくして，端数のあるブロック・タイルも検査する
+ *
+ */
+void test_FilterParam_evaluate_batch()
+{
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 );
+    FilterParam fparam( 7, 4, bands, 200, 50, 5.0 );
+
+    vector< vector< double > > coefs;
+    coefs.emplace_back( vector< double > { 0.025247504683641238,
+
+                                           0.8885952985540255, -4.097963802039866,
+                                           5.496940685423355, 0.3983519261092186,
+                                           0.9723236917140877, 1.1168784833810899,
+                                           0.8492039597182939,
+
+                                           -0.686114259307724, 0.22008381076439384,
+                                           -0.22066728558327908, 0.7668032045079851 } );
+    for ( unsigned int i = 0; i < 20; ++i )
+    {
+        coefs.emplace_back( fparam.init_coef( 0.5, 3.0, 1.5 ) );
+    }
+
+    auto tiling = fparam.tiling();
+    printf(
+        "detected tile : block %llu, candidates %llu\n",
+        static_cast< unsigned long long >( tiling.freq_block ),
+        static_cast< unsigned long long >( tiling.cand_tile ) );
+    assert( tiling.freq_block > 0 && tiling.cand_tile > 0 );
+
+    const vector< TileConfig > configs { tiling, TileConfig( 7, 3 ), TileConfig( 1, 1 ) };
+    for ( const auto& config : configs )
+    {
+        fparam.set_tiling( config );
+        auto values = fparam.evaluate_batch( coefs );
+        assert( values.size() == coefs.size() );
+        for ( std::size_t c = 0; c < coefs.size(); ++c )
+        {
+            const double expect = fparam.evaluate( coefs.at( c ) );
+            assert( std::abs( values.at( c ) - expect ) <= 1.0e-10 * ( 1.0 + expect ) );
+            (void)expect;
+        }
+    }
+    printf( "objective_function_value %f\n", fparam.evaluate_batch( coefs ).at( 0 ) );
+}
+
+/* フィルタ構造体
+ * 密なグリッドでの並列計算が，逐次計算と一致することを確認する
+ * 目的関数値はスレッド数によらずビット単位で一致する
+ *
+ */
+void test_FilterParam_parallel_sweep()
+{
+    vector< double > coef { 0.025247504683641238,
+
+                            0.8885952985540255, -4.097963802039866,
+                            5.496940685423355, 0.3983519261092186,
+                            0.9723236917140877, 1.1168784833810899,
+                            0.8492039597182939,
+
+                            -0.686114259307724, 0.22008381076439384,
+                            -0.22066728558327908, 0.7668032045079851 };
+
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 );
+    FilterParam fparam( 7, 4, bands, 100000, 20000, 5.0 );
+    const auto expect_res = fparam.freq_res( coef );
+    const double expect = fparam.evaluate( coef );
+
+    double first = 0.0;
+    for ( unsigned int nthreads : { 2u, 3u, 8u, 0u } )
+    {
+        fparam.set_parallel_sweep( nthreads );
+        const auto res = fparam.freq_res( coef );
+        const double value = fparam.evaluate( coef );
+        printf( "threads %u : objective_function_value %.15f\n", nthreads, value );
+
+        assert( res.size() == expect_res.size() );
+        for ( unsigned int i = 0; i < res.size(); ++i )
+        {
+            assert( res.at( i ).size() == expect_res.at( i ).size() );
+            for ( unsigned int j = 0; j < res.at( i ).size(); ++j )
+            {
+                assert(
+                    abs( res.at( i ).at( j ) - expect_res.at( i ).at( j ) )
+                    <= 1.0e-12 * ( 1.0 + abs( expect_res.at( i ).at( j ) ) ) );
+            }
+        }
+        assert( std::abs( value - expect ) <= 1.0e-12 * ( 1.0 + expect ) );
+        if ( nthreads == 2u )
+        {
+            first = value;
+        }
+        assert( double_bits( value ) == double_bits( first ) );
+    }
+    (void)expect;
+    (void)first;
+
+    // L2ノルムの和も固定長の区間順に集約するため，スレッド数によらず一致する
+    // (ペナルティに埋もれないよう，近似誤差のみを比べる)
+    ObjectiveConfig l2;
+    l2.norm = ErrorNorm::L2;
+    l2.stability_weight = 0.0;
+    l2.riple_weight = 0.0;
+    fparam.set_objective( l2 );
+    fparam.set_parallel_sweep( 1 );
+    const double serial = fparam.evaluate( coef );
+    double l2_first = 0.0;
+    for ( unsigned int nthreads : { 2u, 3u, 4u, 8u, 0u } )
+    {
+        fparam.set_parallel_sweep( nthreads );
+        const double value = fparam.evaluate( coef );
+        assert( std::abs( value - serial ) <= 1.0e-12 * serial );
+        if ( nthreads == 2u )
+        {
+            l2_first = value;
+        }
+        assert( double_bits( value ) == double_bits( l2_first ) );
+        (void)value;
+    }
+    (void)serial;
+    (void)l2_first;
+}
+
+/* 周波数掃引
+ * FilterParamを構築しない周波数掃引が，FilterParamの周波数特性・
+ * 群遅延特性と一致することを確認する
+ * また，並列計算の結果が逐次計算と一致することを確認する
+ *
+ */
+void test_sweep_response()
+{
+    vector< double > coef { 0.018656458,
+
+                            1.969338828, 1.120102082, 0.388717952,
+                            0.996398946, 1.048137529, 1.037079725,
+                            -4.535575709, 6.381429398,
+
+                            -0.139429968, 0.763426685 };
+    const unsigned int nsplit = 500;
+    auto band = BandParam( BandType::Pass, 0.0, 0.5 );
+    FilterParam fparam( 8, 2, band, nsplit - 1, 0, 5.0 );
+    auto freq_res = fparam.freq_res( coef ).at( 0 );
+    auto group_delay = fparam.group_delay_res( coef ).at( 0 );
+
+    // gen_cswと同じ周波数点
+    vector< double > freq( nsplit );
+    for ( unsigned int i = 0; i < nsplit; ++i )
+    {
+        freq.at( i ) = 0.5 * static_cast< double >( i ) / static_cast< double >( nsplit );
+    }
+
+    vector< complex< double > > response( nsplit );
+    vector< double > magnitude( nsplit ), phase( nsplit ), delay( nsplit );
+    SweepOutput out;
+    out.response = response.data();
+    out.magnitude_db = magnitude.data();
+    out.phase = phase.data();
+    out.group_delay = delay.data();
+    sweep_response( 8, 2, coef, freq.data(), nsplit, out );
+
+    for ( unsigned int i = 0; i < nsplit; ++i )
+    {
+        const complex< double > expect = freq_res.at( i );
+        assert( abs( response.at( i ) - expect ) <= 1.0e-12 * ( 1.0 + abs( expect ) ) );
+        assert( std::abs( magnitude.at( i ) - 20.0 * log10( abs( expect ) ) ) < 1.0e-9 );
+        assert( std::abs( std::remainder( phase.at( i ) - arg( expect ), 2.0 * M_PI ) ) < 1.0e-9 );
+        assert( std::abs( delay.at( i ) - group_delay.at( i ) ) < 1.0e-9 * ( 1.0 + std::abs( group_delay.at( i ) ) ) );
+        (void)expect;
+    }
+
+    // 線形・対数刻みの掃引と並列計算
+    const std::size_t count = 100000;
+    vector< double > grid( count );
+    gen_sweep_grid( 1.0e-4, 0.5, count, SweepScale::Log, grid.data() );
+    assert( std::abs( grid.front() - 1.0e-4 ) < 1.0e-15 && std::abs( grid.back() - 0.5 ) < 1.0e-12 );
+
+    vector< double > serial( count ), parallel( count ), from_grid( count );
+    SweepOutput out_serial, out_parallel, out_grid;
+    out_serial.magnitude_db = serial.data();
+    out_parallel.magnitude_db = parallel.data();
+    out_grid.magnitude_db = from_grid.data();
+    sweep_response( 8, 2, coef, 1.0e-4, 0.5, count, SweepScale::Log, out_serial );
+    sweep_response( 8, 2, coef, 1.0e-4, 0.5, count, SweepScale::Log, out_parallel, 4 );
+    sweep_response( 8, 2, coef, grid.data(), count, out_grid, 3 );
+    for ( std::size_t k = 0; k < count; ++k )
+    {
+        assert( double_bits( serial.at( k ) ) == double_bits( parallel.at( k ) ) );
+        assert( double_bits( serial.at( k ) ) == double_bits( from_grid.at( k ) ) );
+    }
+    printf( "magnitude at %f : %f [dB]\n", grid.at( count / 2 ), serial.at( count / 2 ) );
+}
+
+/* 周波数特性の書き出し
+ * 固定小数点表記の変換がprintfと一致すること，
+ * バイナリ・CSV形式の書き出し結果が計算結果と一致することを確認する
+ *
+ */
+void test_ResponseExporter()
+{
+    char buf[64];
+    char expect[64];
+    const double values[] = { 0.0, -0.0, 1.0, -1.5, 0.1234565, 123456.789, -2.0e-7, 1.0e20, -3.999999999 };
+    for ( const double v : values )
+    {
+        for ( unsigned int precision : { 0u, 3u, 6u, 9u } )
+        {
+            const std::size_t len = write_fixed( v, precision, buf );
+            buf[len] = '\0';
+            snprintf( expect, sizeof( expect ), "%.*f", precision, v );
+            if ( string( buf ) != string( expect ) )
+            {
+                // 丸め位置ちょうどの値は最終桁が異なることがある
+                assert( std::abs( atof( buf ) - atof( expect ) ) <= 1.5 * std::pow( 10.0, -static_cast< double >( precision ) ) );
+            }
+        }
+    }
+
+    vector< vector< double > > coefs {
+        { 0.025247504683641238, 0.8885952985540255, -4.097963802039866,
+          5.496940685423355, 0.3983519261092186, 0.9723236917140877,
+          1.1168784833810899, 0.8492039597182939, -0.686114259307724,
+          0.22008381076439384, -0.22066728558327908, 0.7668032045079851 },
+        { -0.040404875, 0.957674103, 0.765466003, -1.585891794, -1.903482473,
+          -0.441904071, 0.79143639, -1.149627531, 0.965348065, -0.434908839,
+          -1.332562129, 0.838349784 }
+    };
+    ResponseExporter exporter( 0.0, 0.5, 1001 );
+    exporter.add( "no", 7, 4, coefs.at( 0 ) );
+    exporter.add( "mo", 8, 3, coefs.at( 1 ) );
+    assert( exporter.size() == 2 && exporter.points() == 1001 );
+
+    exporter.write_binary( "export_test.bin" );
+    FILE* fp = fopen( "export_test.bin", "rb" );
+    assert( fp != NULL );
+    char magic[8] = {};
+    std::uint64_t header[3] = {};
+    const std::size_t nmagic = fread( magic, 1, 8, fp );
+    const std::size_t nheader = fread( header, sizeof( std::uint64_t ), 3, fp );
+    assert( nmagic == 8 && std::memcmp( magic, "FPRESP01", 8 ) == 0 );
+    assert( nheader == 3 );
+    assert( header[0] == 2 && header[1] == 1001 && header[2] == ResponseExporter::ncolumn );
+    vector< double > data( header[1] * ( 1 + header[0] * header[2] ) );
+    const std::size_t ndata = fread( data.data(), sizeof( double ), data.size(), fp );
+    assert( ndata == data.size() );
+    fclose( fp );
+    std::remove( "export_test.bin" );
+    (void)nmagic;
+    (void)nheader;
+    (void)ndata;
+
+    for ( std::size_t d = 0; d < 2; ++d )
+    {
+        const double* amplitude = data.data() + 1001 * ( 1 + d * ResponseExporter::ncolumn );
+        const unsigned int n_order = d == 0 ? 7 : 8;
+        const unsigned int m_order = d == 0 ? 4 : 3;
+        for ( std::size_t k = 0; k < 1001; k += 100 )
+        {
+            complex< double > res;
+            SweepOutput out;
+            out.response = &res;
+            sweep_response( n_order, m_order, coefs.at( d ), &data.at( k ), 1, out );
+            assert( std::abs( amplitude[k] - abs( res ) ) < 1.0e-12 );
+            assert( double_bits( amplitude[k] ) == double_bits( exporter.column( d, ExportColumn::Amplitude )[k] ) );
+        }
+        (void)amplitude;
+    }
+
+    exporter.write_csv( "export_test.csv" );
+    std::ifstream ifs( "export_test.csv" );
+    string line;
+    getline( ifs, line );
+    printf( "%s\n", line.c_str() );
+    assert( line == "freq,no_amp,no_mag,no_phase,no_gd,mo_amp,mo_mag,mo_phase,mo_gd" );
+    std::size_t row = 0;
+    while ( getline( ifs, line ) )
+    {
+        vector< string > vals;
+        std::stringstream ss { line };
+        string val;
+        while ( getline( ss, val, ',' ) )
+        {
+            vals.emplace_back( val );
+        }
+        assert( vals.size() == 9 );
+        assert( std::abs( atof( vals.at( 0 ).c_str() ) - exporter.frequency().at( row ) ) < 1.0e-9 );
+        assert( std::abs( atof( vals.at( 6 ).c_str() ) - exporter.column( 1, ExportColumn::MagnitudeDb )[row] ) < 1.0e-6 );
+        ++row;
+    }
+    assert( row == 1001 );
+
+    std::remove( "export_test.csv" );
+
+    // 引用符を含むパス・名前は2つ重ねてgnuplotの文字列にする
+    ResponseExporter quoted( 0.0, 0.5, 11 );
+    quoted.add( "it's", 7, 4, coefs.at( 0 ) );
+    quoted.add( "mo", 8, 3, coefs.at( 1 ) );
+    quoted.write_gnuplot(
+        "export_test.dat", "export_test.gp", vector< string > { "export'no.png" },
+        ExportColumn::MagnitudeDb );
+    std::ifstream script( "export_test.gp" );
+    const string text(
+        ( std::istreambuf_iterator< char >( script ) ), std::istreambuf_iterator< char >() );
+    assert( text.find( "set output 'export''no.png'" ) != string::npos );
+    assert( text.find( "title 'it''s'" ) != string::npos );
+    std::remove( "export_test.dat" );
+    std::remove( "export_test.gp" );
+
+    // 描画用の一時ファイルは描画の成否によらず残らない
+    const string tmpdir = "export_test_tmp";
+    mkdir( tmpdir.c_str(), 0700 );
+    const char* old_tmpdir = getenv( "TMPDIR" );
+    const string saved_tmpdir = old_tmpdir != nullptr ? old_tmpdir : "";
+    setenv( "TMPDIR", tmpdir.c_str(), 1 );
+    exporter.plot( vector< string > { "export_test.png" }, ExportColumn::Amplitude );
+    if ( old_tmpdir != nullptr )
+    {
+        setenv( "TMPDIR", saved_tmpdir.c_str(), 1 );
+    }
+    else
+    {
+        unsetenv( "TMPDIR" );
+    }
+    const int removed = rmdir( tmpdir.c_str() );    // 空でなければ失敗する
+    assert( removed == 0 );
+    (void)removed;
+    std::remove( "export_test.png" );
+}
+
+/* 周波数特性の計算方式
+ * 多項式展開(Horner)による周波数特性・目的関数値が
+ * セクション積と一致することを確認する
+ * また，自動選択が次数の組のみで決まり，低次ではHorner，高次ではSectionProductを
+ * 選ぶことを確認する(計算時間の計測はtools/bench_response_engine.cpp)
+ *
+ */
+void test_FilterParam_response_engine()
+{
+    const vector< pair< unsigned int, unsigned int > > orders {
+        { 4, 4 }, { 5, 4 }, { 4, 5 }, { 7, 7 }, { 12, 12 }, { 20, 20 }
+    };
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 );
+
+    // 固定した種から係数を作り，極の半径を0.9以下に抑える
+    // (単位円に近い極では展開した多項式の桁落ちが大きくなり，許容誤差が定まらない)
+    std::mt19937 mt( 33 );
+    std::uniform_real_distribution<> a_range( -0.5, 0.5 );
+    std::uniform_real_distribution<> r_range( 0.0, 0.9 );
+    std::uniform_real_distribution<> theta_range( 0.0, M_PI );
+    auto gen_coef = [&]( unsigned int n_order, unsigned int m_order )
+    {
+        vector< double > coef { a_range( mt ) };
+        for ( unsigned int n = 0; n < n_order; ++n )
+        {
+            coef.emplace_back( a_range( mt ) );
+        }
+        if ( m_order % 2 == 1 )
+        {
+            coef.emplace_back( 2.0 * r_range( mt ) - 0.9 );
+        }
+        for ( unsigned int m = m_order % 2; m < m_order; m += 2 )
+        {
+            const double r = r_range( mt );
+            coef.emplace_back( -2.0 * r * std::cos( theta_range( mt ) ) );
+            coef.emplace_back( r * r );
+        }
+        return coef;
+    };
+
+    for ( const auto& order : orders )
+    {
+        FilterParam fparam( order.first, order.second, bands, 200, 50, 5.0 );
+        const auto coef = gen_coef( order.first, order.second );
+        const auto expect_res = fparam.freq_res( coef );
+        const double expect = fparam.evaluate( coef );
+
+        fparam.set_response_engine( ResponseEngine::Horner );
+        assert( fparam.response_engine() == ResponseEngine::Horner );
+        const auto res = fparam.freq_res( coef );
+        const double value = fparam.evaluate( coef );
+
+        assert( res.size() == expect_res.size() );
+        for ( unsigned int i = 0; i < res.size(); ++i )
+        {
+            assert( res.at( i ).size() == expect_res.at( i ).size() );
+            for ( unsigned int j = 0; j < res.at( i ).size(); ++j )
+            {
+                assert(
+                    abs( res.at( i ).at( j ) - expect_res.at( i ).at( j ) )
+                    <= 1.0e-8 * ( 1.0 + abs( expect_res.at( i ).at( j ) ) ) );
+            }
+        }
+        assert( std::abs( value - expect ) <= 1.0e-8 * ( 1.0 + expect ) );
+        (void)value;
+        (void)expect;
+
+        fparam.set_response_engine( ResponseEngine::Auto );
+        const ResponseEngine selected = fparam.response_engine();
+        assert(
+            selected
+            == ( std::max( order.first, order.second ) <= 8 ? ResponseEngine::Horner
+                                                             : ResponseEngine::SectionProduct ) );
+
+        // 帯域・分割数が異なっても同じ次数の組では同じ方式を選ぶ
+        FilterParam other( order.first, order.second, bands, 100, 20, 3.0 );
+        other.set_response_engine( ResponseEngine::Auto );
+        assert( other.response_engine() == selected );
+        (void)selected;
+    }
+}
+
+/* FFT方式の周波数特性
+ * 実数FFTが定義どおりのDFTと一致することを確認する
+ * また，周波数点がビン間隔に乗るグリッドでFFT方式の周波数特性が
+ * セクション積と一致し，乗らないグリッドではSectionProductに戻ることを確認する
+ *
+ */
+void test_FilterParam_fft_response()
+{
+    // 実数FFT
+    for ( std::size_t npoint : { 2u, 4u, 16u, 256u } )
+    {
+        filter::RealFFT plan( npoint );
+        vector< double > x( npoint - 1 );    // 1点はゼロ詰め
+        for ( std::size_t n = 0; n < x.size(); ++n )
+        {
+            x.at( n ) = std::sin( 0.7 * static_cast< double >( n * n ) ) + 0.1;
+        }
+        vector< complex< double > > spec( npoint / 2 + 1 );
+        plan.forward( x.data(), x.size(), spec.data() );
+        for ( std::size_t k = 0; k <= npoint / 2; ++k )
+        {
+            complex< double > dft( 0.0, 0.0 );
+            for ( std::size_t n = 0; n < x.size(); ++n )
+            {
+                dft += x.at( n )
+                       * std::polar(
+                           1.0, -2.0 * M_PI * static_cast< double >( k * n )
+                                    / static_cast< double >( npoint ) );
+            }
+            assert( abs( spec.at( k ) - dft ) < 1.0e-10 * static_cast< double >( npoint ) );
+        }
+    }
+
+    // 周波数点がビン間隔に乗るグリッド(0.5 / 4096刻み)
+    vector< double > coef { 0.018656458,
+
+                            1.969338828, 1.120102082, 0.388717952,
+                            0.996398946, 1.048137529, 1.037079725,
+                            -4.535575709, 6.381429398,
+
+                            -0.139429968, 0.763426685 };
+    auto band = BandParam( BandType::Pass, 0.0, 0.5 );
+    FilterParam fparam( 8, 2, band, 4095, 0, 5.0 );
+    const auto expect_res = fparam.freq_res( coef );
+    const double expect = fparam.evaluate( coef );
+
+    fparam.set_response_engine( ResponseEngine::FFT );
+    assert( fparam.response_engine() == ResponseEngine::FFT );
+    printf( "fft size : %llu\n", static_cast< unsigned long long >( fparam.fft_size() ) );
+    assert( fparam.fft_size() == 8192 );
+    const auto res = fparam.freq_res( coef );
+    assert( res.size() == 1 && res.at( 0 ).size() == expect_res.at( 0 ).size() );
+    for ( unsigned int j = 0; j < res.at( 0 ).size(); ++j )
+    {
+        assert(
+            abs( res.at( 0 ).at( j ) - expect_res.at( 0 ).at( j ) )
+            <= 1.0e-9 * ( 1.0 + abs( expect_res.at( 0 ).at( j ) ) ) );
+    }
+    assert( std::abs( fparam.evaluate( coef ) - expect ) <= 1.0e-9 * ( 1.0 + expect ) );
+    (void)expect;
+
+    // 計算方式は並列計算・セクションキャッシュの設定より優先する
+    const double fft_value = fparam.evaluate( coef );
+    fparam.set_parallel_sweep( 2 );
+    assert( fparam.response_engine() == ResponseEngine::FFT );
+    assert( fparam.freq_res( coef ) == res );
+    fparam.clear_result_cache();
+    assert( double_bits( fparam.evaluate( coef ) ) == double_bits( fft_value ) );
+    fparam.set_parallel_sweep( 1 );
+    fparam.enable_section_cache( 64 );
+    assert( fparam.freq_res( coef ) == res );
+    fparam.clear_result_cache();
+    assert( double_bits( fparam.evaluate( coef ) ) == double_bits( fft_value ) );
+    fparam.disable_section_cache();
+    (void)fft_value;
+
+    // 周波数点がビン間隔に乗らないグリッド
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 );
+    FilterParam lpf( 8, 2, bands, 200, 50, 5.0 );
+    lpf.set_response_engine( ResponseEngine::FFT );
+    assert( lpf.response_engine() == ResponseEngine::SectionProduct );
+    assert( lpf.fft_size() == 0 );
+
+    // 帯域端はビンに乗るが，先頭の帯域が1点多いため刻みが乗らない複数帯域のグリッド
+    // (刻みのずれは点数分積み上がるため，大きなNでも一致とみなさない)
+    const vector< BandParam > edges {
+        BandParam( BandType::Pass, 0.0, 0.25 ), BandParam( BandType::Transition, 0.25, 0.375 ),
+        BandParam( BandType::Stop, 0.375, 0.5 )
+    };
+    FilterParam misaligned( 8, 2, edges, 192, 64, 5.0 );
+    misaligned.set_response_engine( ResponseEngine::FFT );
+    assert( misaligned.response_engine() == ResponseEngine::SectionProduct );
+    assert( misaligned.fft_size() == 0 );
+
+    // 1帯域でも刻み 0.25 / (2^18 + 1) は最後の点で約1ビンずれる
+    FilterParam dense( 8, 2, BandParam( BandType::Pass, 0.0, 0.25 ), 1u << 18, 0, 5.0 );
+    dense.set_response_engine( ResponseEngine::FFT );
+    assert( dense.response_engine() == ResponseEngine::SectionProduct );
+}
+
+/* # フィルタ構造体
+ * 回転子の漸化式による表の生成が，std::polarで1点ずつ求めた値と
+ * 誤差の範囲で一致することを確認する
+ * 再アンカーの間隔(64点)の前後と，再アンカーを多数回行う点数で確認する
+ *
+ */
+void test_FilterParam_gen_tables()
+{
+    const double gd = 5.5;
+    const vector< BandParam > bands {
+        BandParam( BandType::Pass, 0.0, 0.2 ), BandParam( BandType::Transition, 0.2, 0.275 ),
+        BandParam( BandType::Stop, 0.275, 0.5 )
+    };
+    for ( const auto& band : bands )
+    {
+        for ( unsigned int nsplit : { 1u, 63u, 64u, 65u, 8191u } )
+        {
+            vector< complex< double > > csw( nsplit ), csw2( nsplit ), desire( nsplit );
+            FilterParam::gen_tables( band, nsplit, gd, csw.data(), csw2.data(), desire.data() );
+            const double step = band.width() / static_cast< double >( nsplit );
+
+            double error = 0.0;
+            for ( unsigned int i = 0; i < nsplit; ++i )
+            {
+                const double f = band.left() + step * static_cast< double >( i );
+                error = std::max( error, abs( csw.at( i ) - std::polar( 1.0, -2.0 * M_PI * f ) ) );
+                error =
+                    std::max( error, abs( csw2.at( i ) - std::polar( 1.0, -4.0 * M_PI * f ) ) );
+                if ( band.type() != BandType::Transition )
+                {
+                    const complex< double > expect = band.type() == BandType::Pass
+                                                         ? std::polar( 1.0, -2.0 * M_PI * gd * f )
+                                                         : complex< double >( 0.0, 0.0 );
+                    error = std::max( error, abs( desire.at( i ) - expect ) );
+                }
+            }
+            assert( error < 1.0e-13 );
+            (void)error;
+
+            // 公開している1表ずつの生成関数も同じ値を返す
+            assert( FilterParam::gen_csw( band, nsplit ) == csw );
+            assert( FilterParam::gen_csw2( band, nsplit ) == csw2 );
+            if ( band.type() == BandType::Transition )
+            {
+                desire.clear();
+            }
+            assert( FilterParam::gen_desire_res( band, nsplit, gd ) == desire );
+        }
+    }
+}
+
+/* # フィルタ構造体
+ * コピー・ムーブした構造体が元と同じ特性を返すことを確認する
+ * 周波数グリッドの表は共有されるため，10^6点の構造体のコピーでも
+ * 表の複製が起こらないことを時間で確認する
+ *
+ */
+void test_FilterParam_copy()
+{
+    static_assert( std::is_nothrow_move_constructible< FilterParam >::value, "FilterParam must be nothrow movable" );
+    static_assert( std::is_nothrow_move_assignable< FilterParam >::value, "FilterParam must be nothrow movable" );
+
+    vector< double > coef { 0.025247504683641238,
+
+                            0.8885952985540255, -4.097963802039866,
+                            5.496940685423355, 0.3983519261092186,
+                            0.9723236917140877, 1.1168784833810899,
+                            0.8492039597182939,
+
+                            -0.686114259307724, 0.22008381076439384,
+                            -0.22066728558327908, 0.7668032045079851 };
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 );
+    FilterParam fparam( 7, 4, bands, 800000, 200000, 5.0 );
+    const double expect = fparam.evaluate( coef );
+
+    const std::size_t ncopy = 1000;
+    vector< FilterParam > params;
+    auto start = chrono::steady_clock::now();
+    for ( std::size_t i = 0; i < ncopy; ++i )
+    {
+        params.emplace_back( fparam );
+    }
+    auto end = chrono::steady_clock::now();
+    const double elapsed = chrono::duration< double, std::milli >( end - start ).count();
+    printf( "copy 10^6 points x %llu : %f[ms]\n", static_cast< unsigned long long >( ncopy ), elapsed );
+    assert( elapsed < 1000.0 );
+
+    FilterParam moved( std::move( params.back() ) );
+    params.pop_back();
+    assert( double_bits( moved.evaluate( coef ) ) == double_bits( expect ) );
+    assert( double_bits( params.front().evaluate( coef ) ) == double_bits( expect ) );
+
+    FilterParam assigned( 2, 2, bands, 20, 5, 1.0 );
+    assigned = params.at( 1 );
+    assert( assigned.pole_order() == 4 && assigned.zero_order() == 7 );
+    assert( double_bits( assigned.evaluate( coef ) ) == double_bits( expect ) );
+    (void)expect;
+}
+
+/* # フィルタ構造体
+ * 4通りの次数の偶奇の組について，偶奇を固定した目的関数値の計算が
+ * 周波数特性の配列を経由する計算(セクション応答のキャッシュ有効時)と一致し，
+ * 一括評価とはビット単位で一致することを確認する
+ *
+ */
+void test_FilterParam_parity_dispatch()
+{
+    const vector< pair< unsigned int, unsigned int > > orders {
+        { 4, 4 }, { 5, 5 }, { 5, 4 }, { 4, 5 }, { 1, 1 }, { 0, 2 }
+    };
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 );
+    printf( "sizeof(FilterParam) : %llu\n", static_cast< unsigned long long >( sizeof( FilterParam ) ) );
+
+    for ( const auto& order : orders )
+    {
+        FilterParam fparam( order.first, order.second, bands, 200, 50, 5.0 );
+        vector< vector< double > > coefs;
+        for ( unsigned int k = 0; k < 8; ++k )
+        {
+            coefs.emplace_back( k % 2 == 0 ? fparam.init_coef( 0.5, 1.0, 1.0 ) : fparam.init_stable_coef( 0.5, 1.0 ) );
+        }
+
+        FilterParam generic( fparam );
+        generic.enable_section_cache( 64 );
+        const auto batch = fparam.evaluate_batch( coefs );
+        for ( unsigned int k = 0; k < coefs.size(); ++k )
+        {
+            const double value = fparam.evaluate( coefs.at( k ) );
+            const double expect = generic.evaluate( coefs.at( k ) );
+            assert( std::abs( value - expect ) <= 1.0e-12 * ( 1.0 + std::abs( expect ) ) );
+            assert( double_bits( value ) == double_bits( batch.at( k ) ) );
+            (void)value;
+            (void)expect;
+        }
+        printf( "n_order %u, m_order %u : ok\n", order.first, order.second );
+    }
+}
+
+/* # フィルタ構造体
+ * 長さが合わない係数列を与えた場合に，計算関数の入口でエラー終了することを確認する
+ * (ctestではWILL_FAILとして登録する)
+ *
+ */
+void test_FilterParam_coef_size_check()
+{
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 );
+    FilterParam fparam( 4, 4, bands, 200, 50, 5.0 );
+    vector< double > coef = fparam.init_stable_coef( 0.5, 1.0 );
+    printf( "objective_function_value : %f\n", fparam.evaluate( coef ) );
+
+    coef.emplace_back( 0.0 );    // 1つ長い係数列
+    printf( "objective_function_value : %f\n", fparam.evaluate( coef ) );
+}
+
+/* # フィルタ構造体
+ * 振幅の2乗で比較する目的関数値が，std::absで最大誤差・最大隆起を求めた値と
+ * 丸め誤差の上限の範囲で一致することを確認する
+ *
+ * 上限(u = 2^-53 : 単位丸め誤差)
+ *   sqrt(norm(x))とstd::abs(x)の差 : 4u|x| (FilterParam::evaluate_fullを参照)
+ *   周波数特性の計算順序の違い(評価の計算核とfreq_res) : 1次の誤差解析で，
+ *     各経路の|H|の誤差はセクションごとに 4√2 u (1 + |c1| + |c2|) / |1 + c1 z + c2 z^2|
+ *     (2乗の表との積2回と和2回の丸め)と，セクション間の積・商の丸め 4√2 u の和を
+ *     |H|倍した値以下のため，2経路の差は 8√2 u κ
+ *     κ = max_ω |H| (Σ_k (1 + |c1k| + |c2k|) / |1 + c1k z + c2k z^2| + セクション数)
+ *   安定性のペナルティの加算と減算 : 2u (値 + ペナルティ)
+ *   この差は誤差|D - H|ではなく|H|に比例するため，最大誤差の相対値では抑えられない
+ * 係数列は固定した種の乱数で生成し，実行ごとに同じ係数列で確認する
+ *
+ */
+void test_FilterParam_squared_error()
+{
+    const double gd = 5.0;
+    const unsigned int nsplit = 1000;
+    const unsigned int n_order = 6, m_order = 4;
+    auto pass = BandParam( BandType::Pass, 0.0, 0.5 );
+    auto trans = BandParam( BandType::Transition, 0.0, 0.5 );
+    FilterParam pass_param( n_order, m_order, pass, nsplit - 1, 0, gd );
+    FilterParam trans_param( n_order, m_order, trans, 0, nsplit - 1, gd );
+    trans_param.set_threshold_riple( 0.8 );
+    const auto desire = FilterParam::gen_desire_res( pass, nsplit, gd );
+
+    // init_stable_coefと同じ範囲(分母は安定三角形の内側)
+    std::mt19937 mt( 39 );
+    std::uniform_real_distribution<> a0_range( -0.5, 0.5 );
+    std::uniform_real_distribution<> a_range( -2.0, 2.0 );
+    std::uniform_real_distribution<> b2_range( -1.0, 1.0 );
+    auto gen_coef = [&]()
+    {
+        vector< double > coef { a0_range( mt ) };
+        for ( unsigned int n = 0; n < n_order; ++n )
+        {
+            coef.emplace_back( a_range( mt ) );
+        }
+        for ( unsigned int m = 0; m < m_order; m += 2 )
+        {
+            const double b2 = b2_range( mt );
+            std::uniform_real_distribution<> b1_range( -( b2 + 1.0 ), b2 + 1.0 );
+            coef.emplace_back( b1_range( mt ) );
+            coef.emplace_back( b2 );
+        }
+        return coef;
+    };
+
+    // 計算順序の違いによる|H|の誤差の係数κ
+    auto condition = [&]( const vector< double >& coef, const vector< complex< double > >& res )
+    {
+        double kappa = 0.0;
+        for ( unsigned int j = 0; j < nsplit; ++j )
+        {
+            const complex< double > z =
+                std::polar( 1.0, -M_PI * static_cast< double >( j ) / nsplit );
+            double sum = static_cast< double >( ( n_order + m_order ) / 2 );
+            for ( unsigned int k = 1; k < coef.size(); k += 2 )
+            {
+                const complex< double > section = 1.0 + coef.at( k ) * z + coef.at( k + 1 ) * z * z;
+                sum += ( 1.0 + std::abs( coef.at( k ) ) + std::abs( coef.at( k + 1 ) ) )
+                       / abs( section );
+            }
+            kappa = std::max( kappa, abs( res.at( j ) ) * sum );
+        }
+        return kappa;
+    };
+
+    const double u = std::numeric_limits< double >::epsilon() / 2.0;
+    for ( unsigned int k = 0; k < 100; ++k )
+    {
+        const auto coef = gen_coef();
+        const double stability = 100.0 * pass_param.judge_stability( coef );
+
+        // 通過域 : 最大誤差
+        const auto pass_res = pass_param.freq_res( coef ).at( 0 );
+        const double kappa = condition( coef, pass_res );
+        double max_error = 0.0;
+        for ( unsigned int j = 0; j < nsplit; ++j )
+        {
+            max_error = std::max( max_error, abs( desire.at( j ) - pass_res.at( j ) ) );
+        }
+        assert(
+            std::abs( pass_param.evaluate( coef ) - stability - max_error )
+            <= 4.0 * u * max_error + 8.0 * std::sqrt( 2.0 ) * u * kappa
+                   + 2.0 * u * ( max_error + stability ) );
+
+        // 遷移域 : 最大隆起の2乗
+        //   absの2乗と100倍(5u + u)，normと100倍(2u + u)の差で9u，|H|の差は2|H|倍
+        const auto trans_res = trans_param.freq_res( coef ).at( 0 );
+        const double trans_kappa = condition( coef, trans_res );
+        double max_riple = 0.0;
+        for ( unsigned int j = 0; j < nsplit; ++j )
+        {
+            const double riple = abs( trans_res.at( j ) );
+            if ( riple > 0.8 && riple > max_riple )
+            {
+                max_riple = riple;
+            }
+        }
+        const double trans_expect = 100.0 * max_riple * max_riple;
+        assert(
+            std::abs( trans_param.evaluate( coef ) - stability - trans_expect )
+            <= 9.0 * u * trans_expect
+                   + 100.0 * 2.0 * max_riple * 8.0 * std::sqrt( 2.0 ) * u * trans_kappa
+                   + 2.0 * u * ( trans_expect + stability ) );
+        (void)stability;
+        (void)kappa;
+        (void)max_error;
+        (void)trans_kappa;
+        (void)trans_expect;
+    }
+    (void)u;
+}
+
+/* フィルタ構造体
+ *   目的関数の設定(重み・帯域ごとの重み関数・ノルム)のテスト
+ *   既定の設定では従来の値とビット単位で一致し，
+ *   各ノルムの値が周波数特性から直接求めた値と一致することを確かめる
+ */
+void test_FilterParam_objective_config()
+{
+    const double gd = 5.0;
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 );
+    FilterParam param( 6, 4, bands, 200, 50, gd );
+    FilterParam batch_param( param );
+
+    // 既定の設定は評価ごとに与えても同じ値
+    for ( unsigned int k = 0; k < 20; ++k )
+    {
+        const auto coef = param.init_stable_coef( 0.5, 2.0 );
+        assert( double_bits( param.evaluate( coef ) )
+                == double_bits( param.evaluate( coef, ObjectiveConfig() ) ) );
+    }
+
+    // 近似帯域の誤差を直接求める
+    auto reference = [&]( const vector< double >& coef, ErrorNorm norm, double p,
+                          double pass_weight )
+    {
+        const auto res = param.freq_res( coef );
+        double acc = 0.0;
+        std::size_t count = 0;
+        for ( unsigned int i = 0; i < bands.size(); ++i )
+        {
+            if ( bands[i].type() == BandType::Transition )
+            {
+                continue;
+            }
+            const auto desire = FilterParam::gen_desire_res(
+                bands[i], static_cast< unsigned int >( res[i].size() ), gd );
+            const double w = bands[i].type() == BandType::Pass ? pass_weight : 1.0;
+            for ( unsigned int j = 0; j < res[i].size(); ++j )
+            {
+                const double e = w * abs( desire[j] - res[i][j] );
+                switch ( norm )
+                {
+                    case ErrorNorm::Max: acc = std::max( acc, e ); break;
+                    case ErrorNorm::L2: acc += e * e; break;
+                    case ErrorNorm::Lp:
+                    default: acc += std::pow( e, p ); break;
+                }
+                ++count;
+            }
+        }
+        switch ( norm )
+        {
+            case ErrorNorm::Max: return acc;
+            case ErrorNorm::L2: return std::sqrt( acc / static_cast< double >( count ) );
+            case ErrorNorm::Lp:
+            default: return std::pow( acc / static_cast< double >( count ), 1.0 / p );
+        }
+    };
+
+    const ErrorNorm norms[] = { ErrorNorm::Max, ErrorNorm::L2, ErrorNorm::Lp };
+    for ( const auto norm : norms )
+    {
+        ObjectiveConfig config;
+        config.stability_weight = 0.0;
+        config.riple_weight = 0.0;
+        config.norm = norm;
+        config.p = 4.0;
+        config.band_weight = { []( double f ) { return 1.0 + 10.0 * f; }, nullptr, nullptr };
+        batch_param.set_objective( config );
+
+        ObjectiveConfig flat = config;
+        flat.band_weight.clear();
+
+        vector< vector< double > > coefs;
+        for ( unsigned int k = 0; k < 20; ++k )
+        {
+            coefs.emplace_back( param.init_stable_coef( 0.5, 2.0 ) );
+        }
+        const auto values = batch_param.evaluate_batch( coefs );
+        for ( unsigned int k = 0; k < coefs.size(); ++k )
+        {
+            // 一括評価と1候補の評価は同じ順に累積するため一致する
+            const double value = batch_param.evaluate( coefs[k] );
+            assert( double_bits( values[k] ) == double_bits( value ) );
+            assert( double_bits( value ) == double_bits( param.evaluate( coefs[k], config ) ) );
+
+            const double expect = reference( coefs[k], norm, 4.0, 1.0 );
+            const double flat_value = param.evaluate( coefs[k], flat );
+            assert( std::abs( flat_value - expect ) <= 1.0e-12 * expect );
+
+            // 重み付き : 通過域の重みは1以上なので値は増える
+            assert( value >= flat_value );
+            (void)value;
+            (void)expect;
+            (void)flat_value;
+        }
+    }
+
+    // 通過域の重みを定数2にすると，通過域の誤差が2倍になる
+    ObjectiveConfig doubled;
+    doubled.stability_weight = 0.0;
+    doubled.riple_weight = 0.0;
+    doubled.band_weight = { []( double ) { return 2.0; }, nullptr, nullptr };
+    for ( unsigned int k = 0; k < 20; ++k )
+    {
+        const auto coef = param.init_stable_coef( 0.5, 2.0 );
+        const double expect = reference( coef, ErrorNorm::Max, 2.0, 2.0 );
+        assert( std::abs( param.evaluate( coef, doubled ) - expect ) <= 1.0e-12 * expect );
+        (void)expect;
+    }
+
+    // ペナルティの重みは線形に効く
+    ObjectiveConfig heavy;
+    heavy.stability_weight = 300.0;
+    heavy.riple_weight = 50.0;
+    FilterParam heavy_param( 6, 4, bands, 200, 50, gd, heavy );
+    for ( unsigned int k = 0; k < 20; ++k )
+    {
+        const auto coef = param.init_coef( 0.5, 2.0, 2.0 );
+        ObjectiveConfig error_only;
+        error_only.stability_weight = 0.0;
+        error_only.riple_weight = 0.0;
+        ObjectiveConfig riple_only = error_only;
+        riple_only.riple_weight = 1.0;
+        ObjectiveConfig stability_only = error_only;
+        stability_only.stability_weight = 1.0;
+
+        const double error = param.evaluate( coef, error_only );
+        const double riple = param.evaluate( coef, riple_only ) - error;
+        const double stability = param.evaluate( coef, stability_only ) - error;
+        const double expect = error + 50.0 * riple + 300.0 * stability;
+        assert( std::abs( heavy_param.evaluate( coef ) - expect ) <= 1.0e-10 * expect );
+        (void)expect;
+    }
+
+    // 計算方式によらず同じ値(セクションキャッシュの経路)
+    FilterParam cached( param );
+    ObjectiveConfig l2;
+    l2.norm = ErrorNorm::L2;
+    cached.set_objective( l2 );
+    FilterParam direct( cached );
+    cached.enable_section_cache( 64 );
+    for ( unsigned int k = 0; k < 20; ++k )
+    {
+        const auto coef = param.init_stable_coef( 0.5, 2.0 );
+        const double expect = direct.evaluate( coef );
+        assert( std::abs( cached.evaluate( coef ) - expect ) <= 1.0e-12 * expect );
+        (void)expect;
+    }
+    assert( param.objective().norm == ErrorNorm::Max );
+    assert( cached.objective().norm == ErrorNorm::L2 );
+}
+
+/* フィルタ構造体
+ *   表形式の所望特性ファイルから構築するテスト
+ *   等間隔の通過域と同じ表を与えた場合は帯域から構築したものと一致し，
+ *   不等間隔・任意の振幅位相・重みの表では直接求めた誤差と一致することを確かめる
+ */
+void test_FilterParam_desire_spec()
+{
+    const double gd = 5.0;
+    const unsigned int npoint = 1000;
+    const string uniform_path = "desire_spec_uniform.bin";
+    const string custom_path = "desire_spec_custom.bin";
+
+    // 等間隔の通過域
+    vector< double > freq( npoint ), mag( npoint, 1.0 ), phase( npoint, 0.0 ),
+        weight( npoint, 1.0 );
+    for ( unsigned int j = 0; j < npoint; ++j )
+    {
+        freq[j] = 0.5 * j / npoint;
+    }
+    filter::iir::write_desire_spec(
+        uniform_path, freq.data(), mag.data(), phase.data(), weight.data(), npoint );
+
+    FilterParam band_param( 6, 4, BandParam( BandType::Pass, 0.0, 0.5 ), npoint - 1, 0, gd );
+    FilterParam spec_param( 6, 4, uniform_path, gd );
+    assert( spec_param.partition_approx() == npoint );
+    assert( spec_param.fbands().size() == 1 );
+
+    for ( unsigned int k = 0; k < 20; ++k )
+    {
+        const auto coef = band_param.init_stable_coef( 0.5, 2.0 );
+        const auto expect_res = band_param.freq_res( coef ).at( 0 );
+        const auto res = spec_param.freq_res( coef ).at( 0 );
+        assert( res.size() == npoint );
+        for ( unsigned int j = 0; j < npoint; ++j )
+        {
+            assert( abs( res[j] - expect_res[j] ) <= 1.0e-12 * ( 1.0 + abs( expect_res[j] ) ) );
+        }
+        const double expect = band_param.evaluate( coef );
+        assert( std::abs( spec_param.evaluate( coef ) - expect ) <= 1.0e-12 * expect );
+        (void)expect;
+    }
+
+    // read_csvのOther(path)
+    const string csv_path = "desire_spec_test.csv";
+    {
+        std::ofstream ofs( csv_path );
+        ofs << "No,Numerator,Denominator,State,GroupDelay,NsplitApprox,NsplitTransition\n";
+        ofs << "0,6,4,Other( " << uniform_path << " ),5.0,0,0\n";
+    }
+    string csv_name = csv_path;
+    auto params = FilterParam::read_csv( csv_name );
+    assert( params.size() == 1 );
+    assert( params.at( 0 ).partition_approx() == npoint );
+    assert( params.at( 0 ).zero_order() == 6 && params.at( 0 ).pole_order() == 4 );
+
+    // 不等間隔(対数刻み)・任意の振幅位相・重み
+    for ( unsigned int j = 0; j < npoint; ++j )
+    {
+        freq[j] = 0.001 * std::pow( 500.0, static_cast< double >( j ) / ( npoint - 1 ) );
+        mag[j] = 1.0 + 0.5 * std::sin( 40.0 * freq[j] );
+        phase[j] = 0.3 * std::cos( 25.0 * freq[j] );
+        weight[j] = freq[j] < 0.25 ? 2.0 : ( freq[j] < 0.3 ? 0.0 : 1.0 );
+    }
+    filter::iir::write_desire_spec(
+        custom_path, freq.data(), mag.data(), phase.data(), weight.data(), npoint );
+
+    ObjectiveConfig config;
+    config.stability_weight = 0.0;
+    config.riple_weight = 0.0;
+    FilterParam custom( 6, 4, custom_path, gd, config );
+    FilterParam custom_l2( custom );
+    config.norm = ErrorNorm::L2;
+    custom_l2.set_objective( config );
+
+    for ( unsigned int k = 0; k < 20; ++k )
+    {
+        const auto coef = custom.init_stable_coef( 0.5, 2.0 );
+        double max_error = 0.0;
+        double sum_error2 = 0.0;
+        for ( unsigned int j = 0; j < npoint; ++j )
+        {
+            const complex< double > w = std::polar( 1.0, -2.0 * M_PI * freq[j] );
+            const complex< double > res =
+                filter::iir::cascade_response( coef.data(), 6, 4, w, w * w );
+            const complex< double > desire =
+                mag[j] * std::polar( 1.0, phase[j] - 2.0 * M_PI * gd * freq[j] );
+            const double e = weight[j] * abs( desire - res );
+            max_error = std::max( max_error, e );
+            sum_error2 += e * e;
+        }
+        const double l2 = std::sqrt( sum_error2 / npoint );
+        assert( std::abs( custom.evaluate( coef ) - max_error ) <= 1.0e-10 * max_error );
+        assert( std::abs( custom_l2.evaluate( coef ) - l2 ) <= 1.0e-10 * l2 );
+        (void)l2;
+    }
+
+    std::remove( uniform_path.c_str() );
+    std::remove( custom_path.c_str() );
+    std::remove( csv_path.c_str() );
+}
+
+/* 縦続型IIRフィルタの実行系
+ *   インパルス応答の離散時間フーリエ変換がfreq_resと一致することを確かめる
+ *   ブロックの分け方によらず出力がビット単位で一致すること(状態の保持)も確かめ，
+ *   処理速度を表示する
+ */
+void test_BiquadCascade_impulse()
+{
+    const unsigned int nchannel = 19;    // lane_block + 端数
+    const std::size_t nframe = 4096;
+    const unsigned int orders[][2] = { { 6, 4 }, { 5, 3 }, { 5, 4 }, { 4, 3 }, { 2, 5 } };
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 );
+
+    for ( const auto& order : orders )
+    {
+        FilterParam param( order[0], order[1], bands, 100, 20, 5.0 );
+        vector< double > coef;
+        do
+        {
+            coef = param.init_stable_coef( 0.5, 2.0 );
+        } while ( [&]()
+                  {
+                      for ( const auto& p : param.pole_res( coef ) )
+                      {
+                          if ( abs( p ) > 0.9 )
+                          {
+                              return true;
+                          }
+                      }
+                      return false;
+                  }() );
+
+        // チャネルcには時刻cに振幅(c + 1)のインパルスを入れる
+        vector< double > input( nframe * nchannel, 0.0 );
+        for ( unsigned int c = 0; c < nchannel; ++c )
+        {
+            input[c * nchannel + c] = c + 1.0;
+        }
+
+        filter::iir::BiquadCascade whole( order[0], order[1], coef, nchannel );
+        vector< double > output( input.size() );
+        whole.process( input.data(), output.data(), nframe );
+
+        // ブロックに分けても同じ結果
+        filter::iir::BiquadCascade blocked( order[0], order[1], coef, nchannel );
+        vector< double > blocked_output( input );
+        const std::size_t blocks[] = { 1, 7, 100, 1000 };
+        std::size_t t = 0;
+        for ( unsigned int b = 0; t < nframe; ++b )
+        {
+            const std::size_t len = std::min( blocks[b % 4], nframe - t );
+            blocked.process(
+                blocked_output.data() + t * nchannel, blocked_output.data() + t * nchannel,
+                len );
+            t += len;
+        }
+        for ( std::size_t k = 0; k < output.size(); ++k )
+        {
+            assert( double_bits( output[k] ) == double_bits( blocked_output[k] ) );
+        }
+
+        const auto res = param.freq_res( coef );
+        for ( unsigned int i = 0; i < bands.size(); ++i )
+        {
+            const std::size_t npoint = res[i].size();
+            const double step = bands[i].width() / static_cast< double >( npoint );
+            for ( std::size_t j = 0; j < npoint; ++j )
+            {
+                const double f = bands[i].left() + step * static_cast< double >( j );
+                for ( unsigned int c = 0; c < nchannel; c += 6 )
+                {
+                    complex< double > dtft( 0.0, 0.0 );
+                    for ( std::size_t n = c; n < nframe; ++n )
+                    {
+                        dtft += output[n * nchannel + c]
+                                * std::polar( 1.0, -2.0 * M_PI * f * static_cast< double >( n - c ) );
+                    }
+                    dtft /= c + 1.0;
+                    assert( abs( dtft - res[i][j] ) <= 1.0e-9 * ( 1.0 + abs( res[i][j] ) ) );
+                }
+            }
+        }
+    }
+
+    // 処理速度
+    {
+        const unsigned int nch = 64;
+        const std::size_t block = 1024;
+        FilterParam param( 10, 10, bands, 100, 20, 5.0 );
+        const auto coef = param.init_stable_coef( 0.5, 2.0 );
+        filter::iir::BiquadCascade runtime( 10, 10, coef, nch );
+        vector< double > buf( block * nch, 1.0e-3 );
+        const unsigned int repeat = 200;
+        auto start = std::chrono::steady_clock::now();
+        for ( unsigned int r = 0; r < repeat; ++r )
+        {
+            runtime.process( buf.data(), buf.data(), block );
+        }
+        auto end = std::chrono::steady_clock::now();
+        const double sec = std::chrono::duration< double >( end - start ).count();
+        printf(
+            "order (10, 10), %u channels : %.1f Mchannel-samples/s\n", nch,
+            static_cast< double >( repeat * block * nch ) / sec * 1.0e-6 );
+    }
+}
+
+/* ファイルのフィルタリング
+ *   区間に分けて助走付きで並列に処理した結果が，1つのBiquadCascadeで
+ *   先頭から処理した結果と一致することを確かめる(整数形式の変換も含む)
+ */
+void test_filter_file()
+{
+    const unsigned int nchannel = 3;
+    const std::size_t nframe = 200000;
+    const string in_path = "filter_file_input.bin";
+    const string out_path = "filter_file_output.bin";
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 );
+    FilterParam param( 5, 4, bands, 100, 20, 5.0 );
+
+    vector< double > coef;
+    filter::iir::RootBuffer poles;
+    do
+    {
+        coef = param.init_stable_coef( 0.5, 2.0 );
+        param.pole_batch( vector< vector< double > > { coef }, poles, true );
+    } while ( poles.radius.at( 0 ) > 0.95 || poles.radius.at( 0 ) < 0.5 );
+
+    std::mt19937 mt( 1 );
+    std::uniform_real_distribution<> dist( -1000.0, 1000.0 );
+    vector< double > samples( nframe * nchannel );
+    for ( auto& x : samples )
+    {
+        x = dist( mt );
+    }
+
+    vector< double > expect( samples );
+    filter::iir::BiquadCascade cascade( 5, 4, coef, nchannel );
+    cascade.process( expect.data(), expect.data(), nframe );
+    double scale = 0.0;
+    for ( const auto y : expect )
+    {
+        scale = std::max( scale, std::abs( y ) );
+    }
+
+    // 倍精度 -> 倍精度
+    {
+        FILE* fp = fopen( in_path.c_str(), "wb" );
+        fwrite( samples.data(), sizeof( double ), samples.size(), fp );
+        fclose( fp );
+
+        filter::iir::FileFilterConfig config;
+        config.nchannel = nchannel;
+        config.nthreads = 4;
+        config.chunk_frames = 1000;
+        const auto stats = filter::iir::filter_file( param, coef, in_path, out_path, config );
+        assert( stats.nframe == nframe );
+        assert( stats.nsegment > 1 );
+        assert( stats.warmup_frames > 0 );
+        assert( std::abs( stats.pole_radius - poles.radius.at( 0 ) ) < 1.0e-15 );
+        (void)stats;
+
+        vector< double > output( samples.size() );
+        fp = fopen( out_path.c_str(), "rb" );
+        const std::size_t nread = fread( output.data(), sizeof( double ), output.size(), fp );
+        fclose( fp );
+        assert( nread == output.size() );
+        (void)nread;
+        for ( std::size_t k = 0; k < output.size(); ++k )
+        {
+            assert( std::abs( output[k] - expect[k] ) <= 1.0e-10 * scale );
+        }
+    }
+
+    // int16 -> int16 (四捨五入・飽和)
+    {
+        vector< std::int16_t > input16( samples.size() );
+        for ( std::size_t k = 0; k < samples.size(); ++k )
+        {
+            input16[k] = static_cast< std::int16_t >( std::round( samples[k] ) );
+        }
+        FILE* fp = fopen( in_path.c_str(), "wb" );
+        fwrite( input16.data(), sizeof( std::int16_t ), input16.size(), fp );
+        fclose( fp );
+
+        vector< double > expect16( input16.begin(), input16.end() );
+        filter::iir::BiquadCascade cascade16( 5, 4, coef, nchannel );
+        cascade16.process( expect16.data(), expect16.data(), nframe );
+
+        filter::iir::FileFilterConfig config;
+        config.input_format = filter::iir::SampleFormat::Int16;
+        config.output_format = filter::iir::SampleFormat::Int16;
+        config.nchannel = nchannel;
+        config.nthreads = 3;
+        filter::iir::filter_file( param, coef, in_path, out_path, config );
+
+        vector< std::int16_t > output16( samples.size() );
+        fp = fopen( out_path.c_str(), "rb" );
+        const std::size_t nread =
+            fread( output16.data(), sizeof( std::int16_t ), output16.size(), fp );
+        fclose( fp );
+        assert( nread == output16.size() );
+        (void)nread;
+        for ( std::size_t k = 0; k < output16.size(); ++k )
+        {
+            assert(
+                std::abs( output16[k] - std::min( std::max( expect16[k], -32768.0 ), 32767.0 ) )
+                <= 0.5 + 1.0e-6 );
+        }
+    }
+
+    std::remove( in_path.c_str() );
+    std::remove( out_path.c_str() );
+}
+
+void test_FilterParam_quantized()
+{
+    const unsigned int orders[][2] = { { 8, 8 }, { 7, 5 }, { 6, 3 }, { 5, 4 } };
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 );
+    const QFormat q( 14 );
+
+    for ( const auto& order : orders )
+    {
+        FilterParam param( order[0], order[1], bands, 200, 50, 5.0 );
+        const auto coef = param.init_stable_coef( 0.5, 2.0 );
+        const auto qcoef = FilterParam::quantize( coef, q );
+        const auto dcoef = FilterParam::dequantize( qcoef, q );
+        for ( unsigned int k = 0; k < coef.size(); ++k )
+        {
+            assert( std::abs( dcoef[k] - coef[k] ) <= 0.5 * q.lsb() );
+        }
+        assert(
+            double_bits( param.evaluate_quantized( qcoef, q ) )
+            == double_bits( param.evaluate( dcoef ) ) );
+
+        const ErrorNorm norms[] = { ErrorNorm::Max, ErrorNorm::L2, ErrorNorm::Lp };
+        for ( const auto norm : norms )
+        {
+            ObjectiveConfig config;
+            config.norm = norm;
+            config.p = 4.0;
+            param.set_objective( config );
+
+            // 近傍の値は係数をずらして評価し直した値と丸め誤差の範囲で一致する
+            const auto values = param.evaluate_neighbors( qcoef, q );
+            assert( values.size() == 2 * qcoef.size() );
+            for ( unsigned int k = 0; k < values.size(); ++k )
+            {
+                auto neighbor = qcoef;
+                neighbor[k / 2] += k % 2 == 0 ? -1 : 1;
+                const double ref = param.evaluate_quantized( neighbor, q );
+                assert( std::abs( values[k] - ref ) <= 1.0e-9 * std::max( 1.0, std::abs( ref ) ) );
+                (void)ref;
+            }
+
+            // 区間の点数は値を変えない(帯域の点数で割り切れない点数を含む)
+            const TileConfig tiling = param.tiling();
+            param.set_tiling( TileConfig( 7, tiling.cand_tile ) );
+            const auto blocked = param.evaluate_neighbors( qcoef, q );
+            param.set_tiling( tiling );
+            for ( unsigned int k = 0; k < values.size(); ++k )
+            {
+                assert( double_bits( blocked[k] ) == double_bits( values[k] ) );
+            }
+        }
+        param.set_objective( ObjectiveConfig() );
+
+        // 局所探索は丸めただけの係数列より悪くならない
+        const auto searched = param.search_quantized( coef, q, 50 );
+        assert( param.evaluate_quantized( searched, q ) <= param.evaluate_quantized( qcoef, q ) );
+    }
+
+    // 語長の境界 : int16のQ1.14([-2, 2 - 2^-14])では範囲外の係数は端に飽和し，
+    // 範囲の端を越える近傍は無限大として探索で選ばれない
+    {
+        const QFormat q16( 14, 16 );
+        assert( q16.max_code() == 32767 && q16.min_code() == -32768 );
+        FilterParam param( 6, 4, bands, 200, 50, 5.0 );
+        auto coef = param.init_stable_coef( 0.5, 2.0 );
+        const std::size_t upper = 1 + 6;    // 分母の1次の係数(b1 → 2に近い)
+        const std::size_t lower = 1;    // 分子の1次の係数
+        coef[upper] = 1.99999;    // 32767.8は32768に丸まるため飽和させる
+        coef[lower] = -2.5;
+        const auto qcoef = FilterParam::quantize( coef, q16 );
+        assert( qcoef[upper] == 32767 && qcoef[lower] == -32768 );
+        for ( const auto c : qcoef )
+        {
+            assert( q16.contains( c ) );
+            (void)c;
+        }
+
+        const auto values = param.evaluate_neighbors( qcoef, q16 );
+        assert( std::isinf( values[2 * upper + 1] ) && std::isfinite( values[2 * upper] ) );
+        assert( std::isinf( values[2 * lower] ) && std::isfinite( values[2 * lower + 1] ) );
+        auto inside = qcoef;
+        inside[upper] -= 1;
+        assert(
+            std::abs( values[2 * upper] - param.evaluate_quantized( inside, q16 ) )
+            <= 1.0e-9 * std::max( 1.0, values[2 * upper] ) );
+        (void)values;
+
+        const auto searched = param.search_quantized( coef, q16, 50 );
+        for ( const auto c : searched )
+        {
+            assert( q16.contains( c ) );
+            (void)c;
+        }
+    }
+
+    // 近傍の一括評価と1つずつの評価の時間
+    FilterParam param( 10, 10, bands, 200, 50, 5.0 );
+    const auto qcoef = FilterParam::quantize( param.init_stable_coef( 0.5, 2.0 ), q );
+    const unsigned int repeat = 20;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    double sink = 0.0;
+    for ( unsigned int r = 0; r < repeat; ++r )
+    {
+        for ( unsigned int k = 0; k < 2 * qcoef.size(); ++k )
+        {
+            auto neighbor = qcoef;
+            neighbor[k / 2] += k % 2 == 0 ? -1 : 1;
+            sink += param.evaluate_quantized( neighbor, q );
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    for ( unsigned int r = 0; r < repeat; ++r )
+    {
+        sink += param.evaluate_neighbors( qcoef, q ).at( 0 );
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+
+    const double full = std::chrono::duration< double >( t1 - t0 ).count();
+    const double incremental = std::chrono::duration< double >( t2 - t1 ).count();
+    printf(
+        "neighbors of %u coefficients : full %.3f ms, incremental %.3f ms (x%.1f, %g)\n",
+        param.opt_order(), full / repeat * 1.0e3, incremental / repeat * 1.0e3,
+        full / incremental, sink );
+}
+
+void test_FilterParam_pole_param()
+{
+    const unsigned int orders[][2] = { { 6, 6 }, { 5, 5 }, { 4, 3 }, { 3, 4 } };
+    const PoleForm forms[] = { PoleForm::Polar, PoleForm::Reflection };
+    const double r_max = 0.98;
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 );
+
+    for ( const auto& order : orders )
+    {
+        FilterParam param( order[0], order[1], bands, 200, 50, 5.0 );
+        for ( const auto form : forms )
+        {
+            vector< vector< double > > params;
+            for ( unsigned int k = 0; k < 50; ++k )
+            {
+                auto p = param.init_pole_param( 0.5, 2.0, form, r_max );
+                // 範囲外の媒介変数も打ち切られて安定となる
+                if ( k % 5 == 0 )
+                {
+                    for ( unsigned int i = 1 + order[0]; i < p.size(); ++i )
+                    {
+                        p[i] *= 3.0;
+                    }
+                }
+                params.emplace_back( p );
+            }
+
+            vector< vector< double > > coefs;
+            param.pole_param_to_coef_batch( params, form, r_max, coefs );
+            const auto values = param.evaluate_pole_param_batch( params, form, r_max );
+            for ( unsigned int k = 0; k < params.size(); ++k )
+            {
+                const auto coef = param.pole_param_to_coef( params[k], form, r_max );
+                assert( coef == coefs[k] );
+                assert( double_bits( param.judge_stability( coef ) ) == double_bits( 0.0 ) );
+                // Polarは極の半径を，Reflectionは反射係数を打ち切る
+                const double bound = form == PoleForm::Polar ? r_max + 1.0e-6 : 1.0;
+                for ( const auto& pole : param.pole_res( coef ) )
+                {
+                    assert( abs( pole ) < bound );
+                    (void)pole;
+                }
+                (void)bound;
+
+                // 安定な係数列の評価値と一致する
+                const double value = param.evaluate_pole_param( params[k], form, r_max );
+                assert( double_bits( value ) == double_bits( param.evaluate( coef ) ) );
+                assert( double_bits( value ) == double_bits( values[k] ) );
+                (void)value;
+
+                // 逆変換して写し直すと同じ係数列に戻る
+                const auto back = param.pole_param_to_coef(
+                    param.coef_to_pole_param( coef, form ), form, r_max );
+                for ( unsigned int i = 0; i < coef.size(); ++i )
+                {
+                    assert( std::abs( back[i] - coef[i] ) <= 1.0e-12 );
+                }
+            }
+        }
+    }
+}
+
+void test_FilterParam_riple_bound()
+{
+    const unsigned int orders[][2] = { { 6, 4 }, { 5, 3 }, { 5, 4 }, { 4, 3 } };
+    const vector< BandParam > bands = { BandParam( BandType::Stop, 0.0, 0.1 ),
+                                        BandParam( BandType::Transition, 0.1, 0.15 ),
+                                        BandParam( BandType::Pass, 0.15, 0.3 ),
+                                        BandParam( BandType::Transition, 0.3, 0.35 ),
+                                        BandParam( BandType::Stop, 0.35, 0.5 ) };
+    const double thresholds[] = { 1.0, 0.2, 0.0, -1.0 };
+
+    for ( const auto& order : orders )
+    {
+        FilterParam param( order[0], order[1], bands, 100, 300, 5.0 );
+        FilterParam reference( param );
+        reference.set_riple_bound( false );
+        assert( param.riple_bounding() && !reference.riple_bounding() );
+
+        for ( const auto threshold : thresholds )
+        {
+            param.set_threshold_riple( threshold );
+            reference.set_threshold_riple( threshold );
+
+            // 隆起となる候補・ならない候補の双方で，全点を評価した場合と一致する
+            vector< vector< double > > coefs;
+            for ( unsigned int k = 0; k < 40; ++k )
+            {
+                const double a0 = k % 2 == 0 ? 0.05 : 2.0;
+                coefs.emplace_back( param.init_stable_coef( a0, 1.0 ) );
+            }
+            const auto values = param.evaluate_batch( coefs );
+            const auto ref_values = reference.evaluate_batch( coefs );
+            for ( unsigned int k = 0; k < coefs.size(); ++k )
+            {
+                const double value = param.evaluate( coefs[k] );
+                assert( double_bits( value ) == double_bits( reference.evaluate( coefs[k] ) ) );
+                assert( double_bits( value ) == double_bits( values[k] ) );
+                assert( double_bits( ref_values[k] ) == double_bits( values[k] ) );
+                (void)value;
+            }
+        }
+    }
+
+    // 遷移域の点が多く，隆起の無い候補での時間
+    auto lpf = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 );
+    FilterParam param( 8, 8, lpf, 50, 2000, 5.0 );
+    FilterParam reference( param );
+    reference.set_riple_bound( false );
+    vector< vector< double > > coefs;
+    for ( unsigned int k = 0; k < 200; ++k )
+    {
+        coefs.emplace_back( param.init_stable_coef( 0.01, 0.5 ) );
+    }
+
+    vector< double > full_values( coefs.size() ), bounded_values( coefs.size() );
+    const auto t0 = std::chrono::steady_clock::now();
+    for ( unsigned int k = 0; k < coefs.size(); ++k )
+    {
+        full_values[k] = reference.evaluate( coefs[k] );
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    for ( unsigned int k = 0; k < coefs.size(); ++k )
+    {
+        bounded_values[k] = param.evaluate( coefs[k] );
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+    for ( unsigned int k = 0; k < coefs.size(); ++k )
+    {
+        assert( double_bits( full_values[k] ) == double_bits( bounded_values[k] ) );
+    }
+
+    const double full = std::chrono::duration< double >( t1 - t0 ).count();
+    const double bounded = std::chrono::duration< double >( t2 - t1 ).count();
+    printf(
+        "transition points %u : full %.3f ms, bounded %.3f ms (x%.1f)\n", 2000,
+        full * 1.0e3, bounded * 1.0e3, full / bounded );
+}
+
+void test_FilterParam_retarget()
+{
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 );
+    FilterParam param( 6, 5, bands, 200, 50, 5.0 );
+    param.enable_result_cache( 64 );
+    const vector< double > gds = { 0.0, 3.5, 8.0, 12.25 };
+
+    vector< vector< double > > coefs;
+    for ( unsigned int k = 0; k < 10; ++k )
+    {
+        coefs.emplace_back( param.init_stable_coef( 0.5, 2.0 ) );
+    }
+
+    // 同じ群遅延で構築した場合と一致する
+    const auto batch = param.retarget_batch( gds );
+    assert( batch.size() == gds.size() );
+    for ( unsigned int t = 0; t < gds.size(); ++t )
+    {
+        const FilterParam expect( 6, 5, bands, 200, 50, gds[t] );
+        const FilterParam single = param.retarget( gds[t] );
+        assert( double_bits( single.gd() ) == double_bits( gds[t] ) );
+        assert( double_bits( batch[t].gd() ) == double_bits( gds[t] ) );
+        for ( const auto& coef : coefs )
+        {
+            const double value = expect.evaluate( coef );
+            assert( double_bits( single.evaluate( coef ) ) == double_bits( value ) );
+            assert( double_bits( batch[t].evaluate( coef ) ) == double_bits( value ) );
+            (void)value;
+        }
+        assert( single.evaluate_batch( coefs ) == expect.evaluate_batch( coefs ) );
+    }
+    // 元の構造体は変わらない(評価値のキャッシュも別)
+    const FilterParam original( 6, 5, bands, 200, 50, 5.0 );
+    for ( const auto& coef : coefs )
+    {
+        assert( double_bits( param.evaluate( coef ) ) == double_bits( original.evaluate( coef ) ) );
+        (void)coef;
+    }
+
+    // 閾値の変更
+    FilterParam expect_threshold( param );
+    expect_threshold.set_threshold_riple( 0.3 );
+    const FilterParam threshold = param.with_threshold( 0.3 );
+    assert( double_bits( threshold.threshold() ) == double_bits( 0.3 ) );
+    for ( const auto& coef : coefs )
+    {
+        assert(
+            double_bits( threshold.evaluate( coef ) )
+            == double_bits( expect_threshold.evaluate( coef ) ) );
+        (void)coef;
+    }
+
+    // 表形式の所望特性
+    const string spec_path = "retarget_spec.bin";
+    const unsigned int npoint = 500;
+    vector< double > freq( npoint ), mag( npoint ), phase( npoint ), weight( npoint, 1.0 );
+    for ( unsigned int j = 0; j < npoint; ++j )
+    {
+        freq[j] = 0.4 * j / npoint;
+        mag[j] = 1.0 + 0.5 * freq[j];
+        phase[j] = 0.3 * freq[j];
+    }
+    filter::iir::write_desire_spec(
+        spec_path, freq.data(), mag.data(), phase.data(), weight.data(), npoint );
+    const FilterParam spec_param( 6, 5, spec_path, 2.0 );
+    const FilterParam spec_expect( 6, 5, spec_path, 7.5 );
+    const FilterParam spec_target = spec_param.retarget( 7.5 );
+    for ( const auto& coef : coefs )
+    {
+        assert(
+            double_bits( spec_target.evaluate( coef ) )
+            == double_bits( spec_expect.evaluate( coef ) ) );
+        (void)coef;
+    }
+    std::remove( spec_path.c_str() );
+
+    // 構築し直す場合との時間
+    const unsigned int ntarget = 200;
+    vector< double > sweep( ntarget );
+    for ( unsigned int t = 0; t < ntarget; ++t )
+    {
+        sweep[t] = 0.05 * t;
+    }
+    FilterParam dense( 10, 10, bands, 5000, 1000, 5.0 );
+    const auto t0 = std::chrono::steady_clock::now();
+    double sink = 0.0;
+    for ( const auto gd : sweep )
+    {
+        sink += FilterParam( 10, 10, bands, 5000, 1000, gd ).gd();
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const auto targets = dense.retarget_batch( sweep );
+    const auto t2 = std::chrono::steady_clock::now();
+    const double rebuild = std::chrono::duration< double >( t1 - t0 ).count();
+    const double retargeted = std::chrono::duration< double >( t2 - t1 ).count();
+    printf(
+        "%u targets : rebuild %.3f ms, retarget_batch %.3f ms (x%.1f, %g)\n", ntarget,
+        rebuild * 1.0e3, retargeted * 1.0e3, rebuild / retargeted, sink + targets.back().gd() );
+}
+
+void test_MultiSpecEvaluator()
+{
+    // 群遅延の族(グリッドは共有)と帯域端の異なる仕様を混ぜる
+    auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 );
+    FilterParam base( 6, 5, bands, 200, 50, 5.0 );
+    vector< FilterParam > specs = base.retarget_batch( { 4.0, 4.5, 5.5, 6.0 } );
+    specs.emplace_back( 6, 5, FilterParam::gen_bands( FilterType::LPF, 0.18, 0.28 ), 200, 50, 5.0 );
+    specs.emplace_back( 6, 5, FilterParam::gen_bands( FilterType::LPF, 0.22, 0.32 ), 200, 50, 5.0 );
+    ObjectiveConfig l2;
+    l2.norm = ErrorNorm::L2;
+    specs.back().set_objective( l2 );
+
+    MultiSpecEvaluator evaluator( specs );
+    assert( evaluator.size() == specs.size() );
+
+    // 群遅延の族の4仕様は同じグリッドのため1つにまとまる
+    auto npoint = [&]( const FilterParam& spec )
+    {
+        std::size_t count = 0;
+        for ( const auto& res : spec.freq_res( spec.init_stable_coef( 0.5, 2.0 ) ) )
+        {
+            count += res.size();
+        }
+        return count;
+    };
+    std::size_t total = 0;
+    for ( const auto& spec : specs )
+    {
+        total += npoint( spec );
+    }
+    assert( evaluator.total_points() == total );
+    assert( evaluator.unique_points() <= total - 3 * npoint( base ) );
+
+    for ( unsigned int k = 0; k < 20; ++k )
+    {
+        const auto coef =
+            k % 4 == 0 ? base.init_coef( 0.5, 2.0, 2.0 ) : base.init_stable_coef( 0.5, 2.0 );
+        const MultiSpecResult result = evaluator.evaluate( coef );
+        assert( result.value.size() == specs.size() );
+        double worst = 0.0;
+        for ( unsigned int s = 0; s < specs.size(); ++s )
+        {
+            // 各仕様のevaluateと一致する
+            const double value = specs[s].evaluate( coef );
+            assert( double_bits( result.value[s] ) == double_bits( value ) );
+            worst = std::max( worst, value );
+        }
+        assert( double_bits( result.worst ) == double_bits( worst ) );
+        assert( double_bits( result.value.at( result.worst_index ) ) == double_bits( worst ) );
+    }
+
+    // 仕様ごとに評価する場合との時間
+    vector< double > gds;
+    for ( unsigned int t = 0; t < 32; ++t )
+    {
+        gds.emplace_back( 3.0 + 0.1 * t );
+    }
+    FilterParam dense( 10, 10, bands, 2000, 500, 5.0 );
+    const auto family = dense.retarget_batch( gds );
+    MultiSpecEvaluator family_evaluator( family );
+    const auto coef = dense.init_stable_coef( 0.5, 2.0 );
+    const unsigned int repeat = 10;
+
+    double sink = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for ( unsigned int r = 0; r < repeat; ++r )
+    {
+        for ( const auto& spec : family )
+        {
+            sink += spec.evaluate( coef );
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    for ( unsigned int r = 0; r < repeat; ++r )
+    {
+        sink -= family_evaluator.evaluate( coef ).worst;
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+    const double separate = std::chrono::duration< double >( t1 - t0 ).count();
+    const double shared = std::chrono::duration< double >( t2 - t1 ).count();
+    printf(
+        "%llu specs, %llu -> %llu points : separate %.3f ms, shared %.3f ms (x%.1f, %g)\n",
+        static_cast< unsigned long long >( family.size() ),
+        static_cast< unsigned long long >( family_evaluator.total_points() ),
+        static_cast< unsigned long long >( family_evaluator.unique_points() ),
+        separate / repeat * 1.0e3, shared / repeat * 1.0e3, separate / shared, sink );
+}
+
+void test_SolutionStore()
+{
+    const string store_path = "solution_store_test.bin";
+    std::remove( store_path.c_str() );
+
+    FilterParam near( 6, 4, FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 ), 200, 50, 5.0 );
+    FilterParam far( 6, 4, FilterParam::gen_bands( FilterType::LPF, 0.1, 0.2 ), 200, 50, 5.0 );
+    FilterParam other_order(
+        4, 4, FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 ), 200, 50, 5.0 );
+    const auto near_coef = near.init_stable_coef( 0.5, 2.0 );
+    const auto far_coef = far.init_stable_coef( 0.5, 2.0 );
+    {
+        SolutionStore store( store_path );
+        assert( store.size() == 0 );
+        store.add( near, near_coef, near.evaluate( near_coef ) );
+        store.add( far, far_coef, far.evaluate( far_coef ) );
+        store.add( other_order, other_order.init_stable_coef( 0.5, 2.0 ), 0.0 );
+        assert( store.size() == 3 );
+    }
+
+    // 開き直しても記録が残り，書き込みの途中で終わった末尾は読み飛ばす
+    {
+        FILE* fp = fopen( store_path.c_str(), "ab" );
+        const char partial[5] = { 6, 0, 0, 0, 4 };
+        fwrite( partial, 1, sizeof( partial ), fp );
+        fclose( fp );
+    }
+    SolutionStore store( store_path );
+    assert( store.size() == 3 );
+
+    // 帯域端を少しずらした仕様には近い方の解が先に返る
+    FilterParam target(
+        6, 4, FilterParam::gen_bands( FilterType::LPF, 0.21, 0.31 ), 200, 50, 5.5 );
+    const auto solutions = store.nearest( target, 10 );
+    assert( solutions.size() == 2 );
+    assert( solutions[0].coef == near_coef && solutions[1].coef == far_coef );
+    assert( std::abs( solutions[0].distance - ( 0.04 + 0.01 * 0.5 ) ) < 1.0e-12 );
+    assert( solutions[0].distance < solutions[1].distance );
+    assert( double_bits( solutions[0].value ) == double_bits( near.evaluate( near_coef ) ) );
+    assert( std::isinf( store.distance( target, 2 ) ) );
+
+    // 初期集団は保存した解を良い順に含み，残りはその摂動
+    const auto population = store.seed_population( target, 8, 0.01, 0.5, 2.0 );
+    assert( population.size() == 8 );
+    const bool near_first = target.evaluate( near_coef ) <= target.evaluate( far_coef );
+    assert( population[0] == ( near_first ? near_coef : far_coef ) );
+    assert( population[1] == ( near_first ? far_coef : near_coef ) );
+    (void)near_first;
+    for ( unsigned int k = 2; k < population.size(); ++k )
+    {
+        const auto& seed = population[k % 2];
+        assert( population[k].size() == seed.size() && population[k] != seed );
+        for ( unsigned int i = 0; i < seed.size(); ++i )
+        {
+            assert( std::abs( population[k][i] - seed[i] ) <= 0.1 * std::abs( seed[i] ) );
+        }
+    }
+
+    // 候補が無い仕様は乱数の初期値で埋める
+    FilterParam unknown(
+        8, 8, FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 ), 200, 50, 5.0 );
+    const auto fallback = store.seed_population( unknown, 4, 0.01, 0.5, 2.0 );
+    assert( fallback.size() == 4 && fallback[0].size() == unknown.opt_order() );
+
+    // 途中で終わった末尾を切り詰めてから追記するため，追記した記録も開き直して読める
+    const auto target_coef = target.init_stable_coef( 0.5, 2.0 );
+    store.add( target, target_coef, 1.0 );
+    assert( store.size() == 4 );
+    {
+        SolutionStore reopened( store_path );
+        assert( reopened.size() == 4 );
+        const auto exact = reopened.nearest( target, 1 );
+        assert( exact.size() == 1 && exact[0].coef == target_coef );
+        assert( exact[0].distance < 1.0e-12 );
+        assert( double_bits( exact[0].value ) == double_bits( 1.0 ) );
+        assert( reopened.nearest( near, 1 )[0].coef == near_coef );
+        (void)exact;
+    }
+
+    // 他のプロセスの追記の途中でマップした保存庫が，その追記の完了後に追記しても
+    // 完了した記録を切り詰めない(追記の前に排他の下で読み直す)
+    {
+        std::ifstream ifs( store_path, std::ios::binary );
+        const string whole(
+            ( std::istreambuf_iterator< char >( ifs ) ), std::istreambuf_iterator< char >() );
+        const std::size_t partial = whole.size() - 8;    // 最後の記録の途中まで
+        const int cut = truncate( store_path.c_str(), static_cast< off_t >( partial ) );
+        assert( cut == 0 );
+        (void)cut;
+        SolutionStore stale( store_path );
+        assert( stale.size() == 3 );
+
+        FILE* fp = fopen( store_path.c_str(), "ab" );    // 他のプロセスが追記を終える
+        fwrite( whole.data() + partial, 1, whole.size() - partial, fp );
+        fclose( fp );
+
+        stale.add( near, near_coef, 2.0 );
+        assert( stale.size() == 5 );
+        SolutionStore reopened( store_path );
+        assert( reopened.size() == 5 );
+        assert( reopened.nearest( target, 1 )[0].coef == target_coef );
+    }
+
+    std::remove( store_path.c_str() );
+}
+
+void test_SurrogateScreen()
+{
+    FilterParam param( 6, 4, FilterParam::gen_bands( FilterType::LPF, 0.2, 0.3 ), 200, 50, 5.0 );
+    SurrogateConfig config;
+    config.min_archive = 16;
+    config.fraction = 0.25;
+    config.eval_budget = 60;
+    SurrogateScreen screen( config );
+    assert( std::isinf( screen.predict( param.init_stable_coef( 0.5, 2.0 ) ) ) );
+
+    const unsigned int ntrial = 20;
+    auto generation = [&]()
+    {
+        std::vector< std::vector< double > > trials;
+        for ( unsigned int k = 0; k < ntrial; ++k )
+        {
+            trials.emplace_back( param.init_stable_coef( 0.5, 2.0 ) );
+        }
+        return trials;
+    };
+
+    // 組が少ない間は全候補を本評価する
+    const auto first = generation();
+    const auto warmup = screen.screen( param, first );
+    for ( unsigned int k = 0; k < ntrial; ++k )
+    {
+        assert( warmup.evaluated[k] );
+        assert( double_bits( warmup.value[k] ) == double_bits( param.evaluate( first[k] ) ) );
+    }
+    assert( screen.archive_size() == ntrial );
+    assert( double_bits( screen.predict( first[3] ) ) == double_bits( warmup.value[3] ) );
+
+    // 以降は予測値の良い順にfractionの割合と，残りの候補から無作為にauditの数を本評価する
+    unsigned int ngeneration = 1;
+    std::size_t npair = 0;
+    while ( screen.remaining_budget() >= 5 )
+    {
+        const std::size_t expect = 5 + std::min( config.audit, screen.remaining_budget() - 5 );
+        const auto trials = generation();
+        const auto result = screen.screen( param, trials );
+        unsigned int nevaluated = 0;
+        for ( unsigned int k = 0; k < ntrial; ++k )
+        {
+            if ( result.evaluated[k] )
+            {
+                ++nevaluated;
+                assert(
+                    double_bits( result.value[k] ) == double_bits( param.evaluate( trials[k] ) ) );
+            }
+        }
+        assert( nevaluated == expect );
+        (void)nevaluated;
+        npair += expect * ( expect - 1 ) / 2;
+        ++ngeneration;
+    }
+
+    // 本評価の上限に達した後は予測値のみ返す
+    const auto rest = generation();
+    const auto exhausted = screen.screen( param, rest );
+    for ( unsigned int k = 0; k < ntrial; ++k )
+    {
+        assert( !exhausted.evaluated[k] );
+        assert( double_bits( exhausted.value[k] ) == double_bits( screen.predict( rest[k] ) ) );
+    }
+    ++ngeneration;
+
+    const SurrogateStats& stats = screen.statistics();
+    assert( stats.nevaluated == config.eval_budget && screen.remaining_budget() == 0 );
+    assert( stats.ncandidate == ngeneration * ntrial );
+    assert( stats.ncandidate == stats.nevaluated + stats.npredicted );
+    assert( stats.nchecked == stats.nevaluated - ntrial );
+    assert( stats.naudited == stats.nchecked - 5 * ( ngeneration - 2 ) );
+    assert( stats.npair == npair );
+    (void)npair;
+    printf(
+        "generations : %u, evaluated : %llu / %llu (audited : %llu), concordance : %.3f, "
+        "mean relative error : %.3f\n",
+        ngeneration, static_cast< unsigned long long >( stats.nevaluated ),
+        static_cast< unsigned long long >( stats.ncandidate ),
+        static_cast< unsigned long long >( stats.naudited ), stats.concordance(),
+        stats.mean_relative_error() );
+
+    // 近似誤差の小さい係数列の周りの摂動(目的関数値が距離に応じて滑らかに変わる)では，
+    // 予測値の順位は偶然(0.5)より明らかに当たり，選ばれた候補は無作為に選ぶより良い
+    const vector< double > good { 0.025247504683641238,
+
+                                  0.8885952985540255, -4.097963802039866,
+                                  5.496940685423355, 0.3983519261092186,
+                                  0.9723236917140877, 1.1168784833810899,
+                                  0.8492039597182939,
+
+                                  -0.686114259307724, 0.22008381076439384,
+                                  -0.22066728558327908, 0.7668032045079851 };
+    FilterParam smooth( 7, 4, FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 ), 200, 50, 5.0 );
+    std::mt19937 mt( 50 );
+    std::normal_distribution<> normal( 0.0, 1.0 );
+    std::uniform_real_distribution<> log_sigma( std::log( 1.0e-4 ), std::log( 3.0e-2 ) );
+    auto perturbations = [&]()
+    {
+        std::vector< std::vector< double > > trials;
+        for ( unsigned int k = 0; k < ntrial; ++k )
+        {
+            const double sigma = std::exp( log_sigma( mt ) );
+            vector< double > trial( good );
+            for ( auto& c : trial )
+            {
+                c += sigma * normal( mt ) * std::abs( c );
+            }
+            trials.emplace_back( trial );
+        }
+        return trials;
+    };
+
+    ObjectiveConfig error_only;    // 安定性・隆起のペナルティの段差を含めない
+    error_only.stability_weight = 0.0;
+    error_only.riple_weight = 0.0;
+    smooth.set_objective( error_only );
+    SurrogateScreen local;
+    double selected_sum = 0.0;
+    double all_sum = 0.0;
+    std::size_t nselected = 0;
+    for ( unsigned int g = 0; g < 12; ++g )
+    {
+        const auto trials = perturbations();
+        const auto result = local.screen( smooth, trials );
+        if ( g == 0 )
+        {
+            continue;    // 組が少ない間は全候補を本評価する
+        }
+        for ( unsigned int k = 0; k < ntrial; ++k )
+        {
+            const double exact = smooth.evaluate( trials[k] );
+            all_sum += exact;
+            if ( result.evaluated[k] )
+            {
+                selected_sum += exact;
+                ++nselected;
+            }
+        }
+    }
+    const SurrogateStats& local_stats = local.statistics();
+    const double selected_mean = selected_sum / static_cast< double >( nselected );
+    const double random_mean = all_sum / static_cast< double >( 11 * ntrial );
+    printf(
+        "smooth landscape : concordance : %.3f, selected mean : %.4f, random mean : %.4f\n",
+        local_stats.concordance(), selected_mean, random_mean );
+    assert( local_stats.npair > 100 && local_stats.concordance() > 0.7 );
+    assert( selected_mean < 0.9 * random_mean );
+}
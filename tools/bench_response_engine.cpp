@@ -0,0 +1,62 @@
+/*
+ * bench_response_engine.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * 周波数特性の計算方式(SectionProduct, Horner)の計算時間を次数の組ごとに計測するツール
+ * ResponseEngine::Autoの選択規則(horner_max_order)を決める際に用いる
+ *
+ *   iir-bench-response-engine [max_order] [repeat]
+ *     max_order : 計測する次数の上限(n_order = m_order，既定は24)
+ *     repeat : 1方式あたりの繰り返し回数(既定は2000)
+ */
+
+#include "cascade_iir.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace filter::iir;
+
+int main( int argc, char** argv )
+{
+    std::vector< std::string > args( argv, argv + argc );
+    const unsigned int max_order =
+        args.size() > 1 ? static_cast< unsigned int >( atoi( args[1].c_str() ) ) : 24;
+    const std::size_t repeat =
+        args.size() > 2 ? static_cast< std::size_t >( atol( args[2].c_str() ) ) : 2000;
+
+    const auto bands = FilterParam::gen_bands( FilterType::LPF, 0.2, 0.275 );
+    const ResponseEngine kinds[2] = { ResponseEngine::SectionProduct, ResponseEngine::Horner };
+
+    printf( " n_order m_order  section[us]   horner[us]  auto\n" );
+    for ( unsigned int order = 2; order <= max_order; ++order )
+    {
+        FilterParam param( order, order, bands, 200, 50, 5.0 );
+        const auto coef = param.init_stable_coef( 0.5, 0.5 );
+
+        double elapsed[2] = { 0.0, 0.0 };
+        for ( unsigned int k = 0; k < 2; ++k )
+        {
+            param.set_response_engine( kinds[k] );
+            const auto start = std::chrono::steady_clock::now();
+            for ( std::size_t r = 0; r < repeat; ++r )
+            {
+                param.freq_res( coef );
+            }
+            const auto end = std::chrono::steady_clock::now();
+            elapsed[k] = std::chrono::duration< double, std::micro >( end - start ).count()
+                         / static_cast< double >( repeat );
+        }
+
+        param.set_response_engine( ResponseEngine::Auto );
+        printf(
+            "%8u%8u%13.3f%13.3f  %s\n", order, order, elapsed[0], elapsed[1],
+            param.response_engine() == ResponseEngine::Horner ? "Horner" : "SectionProduct" );
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * filter_file.cpp
+ *
+ *  Created on: 2026/10/18
+ *      Author: agent
+ *
+ * 設計した縦続型IIRフィルタで標本ファイルをフィルタリングするツール
+ *
+ *   iir-filter-file <desire.csv> <No> <coef> <input> <output> [options]
+ *     desire.csv : 所望特性のCSV(FilterParam::read_csvの書式)
+ *     No : 用いる所望特性の番号(次数の取得に用いる)
+ *     coef : 係数列のファイル(a0, a1, ..., b1, ...をカンマ・空白・改行区切り)
+ *     input, output : 入出力ファイル(ヘッダなし，チャネルをインターリーブした標本列)
+ *   options
+ *     -i <format> : 入力の形式(int16, int32, float, double，既定はdouble)
+ *     -o <format> : 出力の形式(既定は入力と同じ)
+ *     -c <n> : チャネル数(既定は1)
+ *     -t <n> : スレッド数(既定は0 = ハードウェアのスレッド数)
+ *     -k <n> : 1度に処理するフレーム数(既定は0 = L2キャッシュから決める)
+ */
+
+#include "cascade_iir.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace filter::iir;
+
+namespace
+{
+    void usage()
+    {
+        fprintf(
+            stderr,
+            "Usage: iir-filter-file <desire.csv> <No> <coef> <input> <output> "
+            "[-i format] [-o format] [-c channels] [-t threads] [-k chunk]\n"
+            "  format : int16, int32, float, double\n" );
+        exit( EXIT_FAILURE );
+    }
+
+    std::vector< double > read_coef( const std::string& path )
+    {
+        std::ifstream ifs( path );
+        if ( !ifs )
+        {
+            fprintf(
+                stderr, "Error: [%s l.%d]Can't open file.(file name : %s, mode : r)\n",
+                __FILE__, __LINE__, path.c_str() );
+            exit( EXIT_FAILURE );
+        }
+
+        std::vector< double > coef;
+        std::string token;
+        while ( ifs >> token )
+        {
+            std::replace( token.begin(), token.end(), ',', ' ' );
+            std::stringstream ss( token );
+            double value = 0.0;
+            while ( ss >> value )
+            {
+                coef.emplace_back( value );
+            }
+        }
+        return coef;
+    }
+}    // namespace
+
+int main( int argc, char** argv )
+{
+    std::vector< std::string > args( argv, argv + argc );
+    if ( args.size() < 6 )
+    {
+        usage();
+    }
+
+    FileFilterConfig config;
+    bool output_given = false;
+    for ( std::size_t k = 6; k < args.size(); k += 2 )
+    {
+        if ( k + 1 >= args.size() )
+        {
+            usage();
+        }
+        const std::string& value = args[k + 1];
+        if ( args[k] == "-i" )
+        {
+            config.input_format = analyze_sample_format( value );
+        }
+        else if ( args[k] == "-o" )
+        {
+            config.output_format = analyze_sample_format( value );
+            output_given = true;
+        }
+        else if ( args[k] == "-c" )
+        {
+            config.nchannel = static_cast< unsigned int >( atoi( value.c_str() ) );
+        }
+        else if ( args[k] == "-t" )
+        {
+            config.nthreads = static_cast< unsigned int >( atoi( value.c_str() ) );
+        }
+        else if ( args[k] == "-k" )
+        {
+            config.chunk_frames = static_cast< std::size_t >( atol( value.c_str() ) );
+        }
+        else
+        {
+            usage();
+        }
+    }
+    if ( !output_given )
+    {
+        config.output_format = config.input_format;
+    }
+
+    std::string csv_path = args[1];
+    const auto params = FilterParam::read_csv( csv_path );
+    const std::size_t index = static_cast< std::size_t >( atol( args[2].c_str() ) );
+    if ( index >= params.size() )
+    {
+        fprintf(
+            stderr, "Error: [%s l.%d]No is out of range.(No : %llu, size : %llu)\n",
+            __FILE__, __LINE__, static_cast< unsigned long long >( index ),
+            static_cast< unsigned long long >( params.size() ) );
+        exit( EXIT_FAILURE );
+    }
+    const auto coef = read_coef( args[3] );
+
+    const auto start = std::chrono::steady_clock::now();
+    const FileFilterStats stats =
+        filter_file( params[index], coef, args[4], args[5], config );
+    const auto end = std::chrono::steady_clock::now();
+    const double sec = std::chrono::duration< double >( end - start ).count();
+
+    printf(
+        "frames : %llu, channels : %u, segments : %llu, warmup : %llu, pole radius : "
+        "%.6f\n",
+        static_cast< unsigned long long >( stats.nframe ), config.nchannel,
+        static_cast< unsigned long long >( stats.nsegment ),
+        static_cast< unsigned long long >( stats.warmup_frames ), stats.pole_radius );
+    printf(
+        "elapsed : %.3f s (%.1f Mchannel-samples/s)\n", sec,
+        static_cast< double >( stats.nframe * config.nchannel ) / sec * 1.0e-6 );
+    return 0;
+}